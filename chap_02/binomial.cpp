@@ -0,0 +1,158 @@
+#include "binomial.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <stdexcept>
+
+namespace pascal
+{
+	namespace
+	{
+		std::uint32_t multiply_mod(std::uint32_t a, std::uint32_t b, std::uint32_t p)
+		{
+			return static_cast<std::uint32_t>(std::uint64_t{ a } * b % p);
+		}
+
+		std::uint32_t power_mod(std::uint32_t base, std::uint32_t exponent, std::uint32_t p)
+		{
+			std::uint32_t result = 1 % p;
+			for (; exponent; exponent >>= 1) {
+				if (exponent & 1) {
+					result = multiply_mod(result, base, p);
+				}
+				base = multiply_mod(base, base, p);
+			}
+			return result;
+		}
+	}
+
+	BinomialTable::BinomialTable(std::uint32_t prime, std::size_t max_n) :
+		prime_(prime)
+	{
+		if (prime < 2) {
+			throw std::invalid_argument("Modulus must be prime");
+		}
+		// Beyond p - 1 every factorial is 0 mod p, so Lucas takes over.
+		const std::size_t size = std::min<std::size_t>(max_n, prime - 1) + 1;
+		factorial_.resize(size);
+		inverse_factorial_.resize(size);
+		factorial_[0] = 1 % prime;
+		for (std::size_t i = 1; i < size; ++i) {
+			factorial_[i] = multiply_mod(factorial_[i - 1], static_cast<std::uint32_t>(i), prime);
+		}
+		inverse_factorial_[size - 1] = power_mod(factorial_[size - 1], prime - 2, prime);
+		for (std::size_t i = size - 1; i > 0; --i) {
+			inverse_factorial_[i - 1] = multiply_mod(inverse_factorial_[i], static_cast<std::uint32_t>(i), prime);
+		}
+	}
+
+	std::uint32_t BinomialTable::small(std::uint64_t n, std::uint64_t k) const
+	{
+		if (k > n) {
+			return 0;
+		}
+		return multiply_mod(factorial_[n],
+			multiply_mod(inverse_factorial_[k], inverse_factorial_[n - k], prime_),
+			prime_);
+	}
+
+	std::uint32_t BinomialTable::lucas(std::uint64_t n, std::uint64_t k) const
+	{
+		std::uint32_t result = 1 % prime_;
+		while (k && result) {
+			result = multiply_mod(result, small(n % prime_, k % prime_), prime_);
+			n /= prime_;
+			k /= prime_;
+		}
+		return result;
+	}
+
+	std::uint32_t BinomialTable::operator()(std::uint64_t n, std::uint64_t k) const
+	{
+		if (k > n) {
+			return 0;
+		}
+		if (n < factorial_.size()) {
+			return small(n, k);
+		}
+		if (factorial_.size() < prime_) {
+			throw std::out_of_range("Row beyond the factorial table");
+		}
+		return lucas(n, k);
+	}
+
+	void BinomialTable::operator()(std::span<const BinomialQuery> queries,
+		std::span<std::uint32_t> results) const
+	{
+		assert(results.size() >= queries.size());
+		std::ranges::transform(queries, results.begin(),
+			[this](const BinomialQuery& query) { return (*this)(query.n, query.k); });
+	}
+
+	// Multiplies in (n - k + i) / i one step at a time. Dividing the
+	// gcd out first keeps every step exact, so the only failure is a
+	// result that is genuinely too big.
+	std::optional<exact_binomial_t> exact_binomial(std::uint64_t n, std::uint64_t k)
+	{
+		if (k > n) {
+			return exact_binomial_t{ 0 };
+		}
+		k = std::min(k, n - k);
+		constexpr auto max = static_cast<exact_binomial_t>(~exact_binomial_t{ 0 });
+		exact_binomial_t result = 1;
+		for (std::uint64_t i = 1; i <= k; ++i) {
+			// gcd(result, i) == gcd(result % i, i), which fits in 64 bits.
+			const std::uint64_t common = std::gcd(static_cast<std::uint64_t>(result % i), i);
+			result /= common;
+			exact_binomial_t numerator = (n - k + i) / (i / common);
+			if (result > max / numerator) {
+				return {};
+			}
+			result *= numerator;
+		}
+		return result;
+	}
+
+	void exact_binomial(std::span<const BinomialQuery> queries,
+		std::span<std::optional<exact_binomial_t>> results)
+	{
+		assert(results.size() >= queries.size());
+		std::ranges::transform(queries, results.begin(),
+			[](const BinomialQuery& query) { return exact_binomial(query.n, query.k); });
+	}
+
+	void check_binomial_properties(std::size_t rows)
+	{
+		const BinomialTable large(1'000'000'007, rows);
+		const BinomialTable lucas(7, rows);
+		std::vector<std::uint32_t> large_row{ 1 }, lucas_row{ 1 };
+		ExactRow exact;
+		for (std::size_t n = 0; n < rows; ++n, exact.advance()) {
+			for (std::size_t k = 0; k <= n; ++k) {
+				assert(large(n, k) == large_row[k]);
+				assert(lucas(n, k) == lucas_row[k]);
+				auto value = exact_binomial(n, k);
+				auto expected = exact.at(k);
+				const auto& limbs = expected.limbs();
+				// How many 64-bit limbs fit in exact_binomial_t.
+				constexpr auto max_limbs = sizeof(exact_binomial_t) / sizeof(std::uint64_t);
+				assert(value.has_value() == (limbs.size() <= max_limbs));
+				if (value) {
+					exact_binomial_t packed = 0;
+					for (auto limb = limbs.rbegin(); limb != limbs.rend(); ++limb) {
+						packed = (max_limbs > 1 ? packed << 32 << 32 : 0) | *limb;
+					}
+					assert(*value == packed);
+				}
+			}
+			assert(large(n, n + 1) == 0);
+			large_row.push_back(1);
+			lucas_row.push_back(1);
+			for (std::size_t k = n; k > 0; --k) {
+				large_row[k] = (large_row[k] + large_row[k - 1]) % large.prime();
+				lucas_row[k] = (lucas_row[k] + lucas_row[k - 1]) % lucas.prime();
+			}
+		}
+	}
+}
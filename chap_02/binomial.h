@@ -0,0 +1,54 @@
+#pragma once
+
+#include "exact_triangle.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace pascal
+{
+#if defined(__SIZEOF_INT128__)
+	using exact_binomial_t = uint128;
+#else
+	using exact_binomial_t = std::uint64_t;
+#endif
+
+	struct BinomialQuery
+	{
+		std::uint64_t n;
+		std::uint64_t k;
+	};
+
+	// Answers C(n, k) mod p for a prime p from factorial and
+	// inverse factorial tables, without building any rows.
+	// If the tables reach p - 1, Lucas's theorem handles any n;
+	// otherwise n must stay below max_n.
+	class BinomialTable
+	{
+	public:
+		BinomialTable(std::uint32_t prime, std::size_t max_n);
+
+		std::uint32_t prime() const { return prime_; }
+		std::uint32_t operator()(std::uint64_t n, std::uint64_t k) const;
+		void operator()(std::span<const BinomialQuery> queries,
+			std::span<std::uint32_t> results) const;
+	private:
+		std::uint32_t small(std::uint64_t n, std::uint64_t k) const;
+		std::uint32_t lucas(std::uint64_t n, std::uint64_t k) const;
+
+		std::uint32_t prime_;
+		std::vector<std::uint32_t> factorial_;
+		std::vector<std::uint32_t> inverse_factorial_;
+	};
+
+	// C(n, k) exactly, or nothing if it does not fit.
+	std::optional<exact_binomial_t> exact_binomial(std::uint64_t n, std::uint64_t k);
+
+	void exact_binomial(std::span<const BinomialQuery> queries,
+		std::span<std::optional<exact_binomial_t>> results);
+
+	void check_binomial_properties(std::size_t rows);
+}
@@ -1,14 +1,32 @@
+#include "binomial.h"
+#include "exact_triangle.h"
+#include "flat_triangle.h"
+#include "frame.h"
+#include "row_kernel.h"
+#include "row_stream.h"
+#include "sierpinski.h"
+
 #include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
 #include <vector>
 #include <format>
 #include <cassert>
 #include <numeric>
+#include <optional>
+#include <random>
 #include <ranges>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
 
-std::vector<int> get_next_row(const std::vector<int>& last_row) {
-	std::vector next_row{ 1 };
+template <typename T = int>
+std::vector<T> get_next_row(const std::vector<T>& last_row) {
+	std::vector<T> next_row{ 1 };
 	if (last_row.empty()) {
 		return next_row;
 	}
@@ -20,8 +38,9 @@ std::vector<int> get_next_row(const std::vector<int>& last_row) {
 	return next_row;
 }
 
+template <typename T = int>
 auto generate_triangle(int rows) {
-	std::vector<std::vector<int>> triangle{ {1} };
+	std::vector<std::vector<T>> triangle{ {1} };
 	for (int row = 1; row < rows; row++)
 	{
 		triangle.push_back(get_next_row(triangle.back()));
@@ -40,8 +59,14 @@ std::ostream& operator<<(std::ostream& os, const std::vector<std::vector<T>>& tr
 	return os;
 }
 
-void show_vectors(std::ostream& os, const std::vector<std::vector<int>>& v) {
-	size_t final_row_size = v.back().size();
+// Rows to iterate over, and how many of them there are, which is
+// also the length of the last row. vector<vector<int>>,
+// pascal::FlatTriangle and pascal::RowStream all qualify.
+template <typename T>
+concept Triangle = std::ranges::input_range<T> && std::ranges::sized_range<T>;
+
+void show_vectors(std::ostream& os, Triangle auto&& v) {
+	size_t final_row_size = std::ranges::size(v);
 	std::string spaces(final_row_size * 3, ' ');
 	for (const auto& row : v) {
 		os << spaces;
@@ -56,14 +81,14 @@ void show_vectors(std::ostream& os, const std::vector<std::vector<int>>& v) {
 
 }
 
-bool is_palindrome(const std::vector<int>& v) {
+bool is_palindrome(std::span<const int> v) {
 	auto forward = v | std::views::take(v.size() / 2);
 	auto backward = v | std::views::reverse | std::views::take(v.size() / 2);
 	return std::ranges::equal(forward, backward);
 }
 
-void show_view(std::ostream& os, const std::vector<std::vector<int>>& v) {
-	std::string spaces(v.back().size(), ' ');
+void show_view(std::ostream& os, Triangle auto&& v) {
+	std::string spaces(std::ranges::size(v), ' ');
 	for (const auto& row : v) {
 		os << spaces;
 		if (spaces.size()) {
@@ -77,25 +102,255 @@ void show_view(std::ostream& os, const std::vector<std::vector<int>>& v) {
 	} 
 }
 
-void check_properties(const std::vector<std::vector<int>>& triangle) {
-	size_t row_number = 1;
-	int expected_total = 1;
+// Row n is n + 1 long, so each row can be checked on its own.
+std::span<const int> check_row(std::span<const int> row) {
 	auto negative = [](int x) {return x < 0; };
+	assert(!row.empty());
+	assert(row.front() == 1);
+	assert(row.back() == 1);
+	const std::int64_t expected_total = std::int64_t{ 1 } << (row.size() - 1);
+	assert(std::accumulate(row.begin(), row.end(), std::int64_t{ 0 }) == expected_total);
+	auto negatives = row | std::views::filter(negative);
+	assert(negatives.empty());
+	assert(is_palindrome(row));
+	return row;
+}
+
+void check_properties(Triangle auto&& triangle) {
+	size_t row_number = 1;
 	for (const auto& row : triangle) {
-		assert(row.front() == 1);
-		assert(row.back() == 1);
 		assert(row.size() == row_number++);
-		assert(std::accumulate(row.begin(), row.end(), 0) == expected_total);
-		expected_total *= 2;
-		auto negatives = row | std::views::filter(negative);
-		assert(negatives.empty());
-		assert(is_palindrome(row));
+		check_row(row);
+	}
+}
+
+template <typename F>
+double rows_per_second(size_t rows, int repeats, F generate) {
+	size_t checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < repeats; ++i) {
+		checksum += generate(rows);
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	assert(checksum == rows * repeats);
+	return static_cast<double>(checksum) / elapsed.count();
+}
+
+void benchmark_generation(std::ostream& os) {
+	auto int_rows = [](size_t rows) {
+		return generate_triangle(static_cast<int>(rows)).size();
+	};
+	auto exact_rows = [](size_t rows) {
+		pascal::ExactRow row;
+		while (row.size() < rows) {
+			row.advance();
+		}
+		return row.size();
+	};
+	// int overflows after row 34, so that is as far as it can be compared
+	os << std::format("{:>24} {:>8} {:>16}\n", "path", "rows", "rows/sec");
+	os << std::format("{:>24} {:>8} {:>16.0f}\n", "vector<vector<int>>", 34,
+		rows_per_second(34, 20000, int_rows));
+	const std::pair<size_t, int> runs[]{ { 34, 20000 }, { 68, 10000 }, { 132, 2000 }, { 1000, 20 }, { 4000, 1 } };
+	for (auto [rows, repeats] : runs) {
+		os << std::format("{:>24} {:>8} {:>16.0f}\n", "ExactRow", rows,
+			rows_per_second(rows, repeats, exact_rows));
+	}
+}
+
+template <typename F>
+double seconds_taken(F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+
+// Values wrap modulo 2^32 well before 10k rows, so unsigned keeps
+// both layouts well defined while doing the same work.
+void benchmark_storage(std::ostream& os) {
+	constexpr int rows = 10'000;
+	auto sum_all = [](const auto& triangle) {
+		unsigned total = 0;
+		for (const auto& row : triangle) {
+			for (unsigned value : row) {
+				total += value;
+			}
+		}
+		return total;
+	};
+	os << std::format("{:>24} {:>12} {:>12}\n", "storage", "generate s", "traverse s");
+
+	unsigned nested_total = 0;
+	double nested_traverse = 0;
+	double nested_generate = seconds_taken([&] {
+		auto triangle = generate_triangle<unsigned>(rows);
+		nested_traverse = seconds_taken([&] { nested_total = sum_all(triangle); });
+		});
+	os << std::format("{:>24} {:>12.3f} {:>12.3f}\n", "vector<vector<unsigned>>",
+		nested_generate - nested_traverse, nested_traverse);
+
+	unsigned flat_total = 0;
+	double flat_traverse = 0;
+	double flat_generate = seconds_taken([&] {
+		auto triangle = pascal::generate_flat_triangle<unsigned>(rows);
+		flat_traverse = seconds_taken([&] { flat_total = sum_all(triangle); });
+		});
+	os << std::format("{:>24} {:>12.3f} {:>12.3f}\n", "FlatTriangle<unsigned>",
+		flat_generate - flat_traverse, flat_traverse);
+
+	assert(nested_total == flat_total);
+}
+
+void benchmark_kernels(std::ostream& os) {
+	constexpr size_t rows = 10'000;
+	os << std::format("{:>24} {:>12} {:>12}\n", "kernel", "out-of-place", "in-place");
+	os << std::format("{:>24} {:>12.3f} {:>12}\n", "get_next_row", seconds_taken([] {
+		std::vector<unsigned> row{ 1 };
+		for (size_t n = 1; n < rows; ++n) {
+			row = get_next_row(row);
+		}
+		}), "-");
+	for (auto kernel : { pascal::Kernel::Scalar, pascal::Kernel::SSE2, pascal::Kernel::AVX2 }) {
+		if (!pascal::is_supported(kernel)) {
+			continue;
+		}
+		std::vector<std::uint32_t> last(rows, 0), next(rows, 0), in_place(rows, 0);
+		last.front() = in_place.front() = 1;
+		double out_of_place = seconds_taken([&] {
+			for (size_t n = 1; n < rows; ++n) {
+				pascal::next_row(kernel, std::span(last).first(n), std::span(next).first(n + 1));
+				std::swap(last, next);
+			}
+			});
+		double updated = seconds_taken([&] {
+			for (size_t n = 1; n < rows; ++n) {
+				pascal::next_row_in_place(kernel, std::span(in_place).first(n + 1));
+			}
+			});
+		assert(last == in_place);
+		os << std::format("{:>24} {:>12.3f} {:>12.3f}\n", pascal::to_string(kernel), out_of_place, updated);
 	}
 }
 
-int main() {
-	auto triangle = generate_triangle(32);
-	check_properties(triangle);
-	show_view(std::cout, triangle);
-	//show_vectors(std::cout, triangle);
+std::vector<pascal::BinomialQuery> random_queries(size_t count, std::uint64_t max_n) {
+	std::mt19937_64 engine{ 2024 };
+	std::uniform_int_distribution<std::uint64_t> row(0, max_n);
+	std::vector<pascal::BinomialQuery> queries(count);
+	for (auto& query : queries) {
+		query.n = row(engine);
+		query.k = std::uniform_int_distribution<std::uint64_t>(0, query.n)(engine);
+	}
+	return queries;
+}
+
+void benchmark_binomial(std::ostream& os) {
+	constexpr size_t count = 1'000'000;
+	constexpr std::uint64_t max_n = 2'000;
+	auto queries = random_queries(count, max_n - 1);
+	std::vector<std::uint32_t> results(count);
+	os << std::format("{:>24} {:>16}\n", "C(n, k) lookup", "queries/sec");
+
+	double nested = seconds_taken([&] {
+		auto triangle = generate_triangle<unsigned>(static_cast<int>(max_n));
+		std::ranges::transform(queries, results.begin(),
+			[&triangle](const auto& query) { return triangle[query.n][query.k]; });
+		});
+	os << std::format("{:>24} {:>16.0f}\n", "generate_triangle", count / nested);
+
+	const pascal::BinomialTable table(1'000'000'007, max_n);
+	os << std::format("{:>24} {:>16.0f}\n", "factorial table mod p",
+		count / seconds_taken([&] { table(queries, results); }));
+
+	const pascal::BinomialTable lucas(7, 6);
+	auto huge_queries = random_queries(count, std::uint64_t{ 1 } << 62);
+	os << std::format("{:>24} {:>16.0f}\n", "Lucas mod 7, n < 2^62",
+		count / seconds_taken([&] { lucas(huge_queries, results); }));
+
+	auto exact_queries = random_queries(count, 130);
+	std::vector<std::optional<pascal::exact_binomial_t>> exact(count);
+	os << std::format("{:>24} {:>16.0f}\n", "exact, n <= 130",
+		count / seconds_taken([&] { pascal::exact_binomial(exact_queries, exact); }));
+}
+
+// Counts what is written and throws it away, so only formatting is timed.
+class CountingBuffer : public std::streambuf {
+public:
+	size_t bytes = 0;
+protected:
+	int_type overflow(int_type ch) override {
+		++bytes;
+		return traits_type::not_eof(ch);
+	}
+	std::streamsize xsputn(const char*, std::streamsize count) override {
+		bytes += static_cast<size_t>(count);
+		return count;
+	}
+};
+
+void benchmark_rendering(std::ostream& os) {
+	constexpr size_t rows = 1'000;
+	pascal::FlatTriangle<int> triangle(rows);
+	for (size_t n = 0; const auto& row : pascal::RowStream(rows)) {
+		std::ranges::copy(row, triangle[n++].begin());
+	}
+
+	std::ostringstream expected, actual;
+	show_vectors(expected, triangle);
+	show_view(expected, triangle);
+	pascal::Frame frame;
+	frame.vectors(triangle).view(triangle).flush(actual);
+	assert(expected.view() == actual.view());
+
+	os << std::format("{:>24} {:>16}\n", "renderer", "bytes/sec");
+	auto measure = [&](std::string_view name, auto render) {
+		CountingBuffer counter;
+		std::ostream out(&counter);
+		double taken = seconds_taken([&] { render(out); });
+		os << std::format("{:>24} {:>16.0f}\n", name, counter.bytes / taken);
+	};
+	measure("show_vectors", [&](std::ostream& out) { show_vectors(out, triangle); });
+	measure("Frame::vectors", [&](std::ostream& out) { frame.vectors(triangle).flush(out); });
+	measure("show_view", [&](std::ostream& out) { show_view(out, triangle); });
+	measure("Frame::view", [&](std::ostream& out) { frame.view(triangle).flush(out); });
+}
+
+// A whole number from first to last, or nothing if text is anything else.
+std::optional<std::size_t> parse_count(std::string_view text, std::size_t first, std::size_t last) {
+	std::size_t value = 0;
+	auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+	if (ec != std::errc{} || end != text.data() + text.size() || value < first || value > last) {
+		return {};
+	}
+	return value;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc > 1 && std::string_view(argv[1]) == "--bench") {
+		benchmark_generation(std::cout);
+		benchmark_storage(std::cout);
+		benchmark_kernels(std::cout);
+		benchmark_binomial(std::cout);
+		benchmark_rendering(std::cout);
+		return 0;
+	}
+	if (argc > 1 && std::string_view(argv[1]) == "--sierpinski") {
+		constexpr std::size_t max_rows = 10'000'000;
+		const auto rows = argc > 2 ? parse_count(argv[2], 1, max_rows) : std::nullopt;
+		if (!rows) {
+			std::cerr << std::format("Usage: pascal --sierpinski <rows>, with 1 to {} rows\n", max_rows);
+			return 1;
+		}
+		pascal::show_sierpinski(std::cout, *rows);
+		return 0;
+	}
+	check_properties(generate_triangle(32));
+	check_properties(pascal::generate_flat_triangle(32));
+	pascal::check_exact_properties(200);
+	pascal::check_kernels(200);
+	pascal::check_parity_properties(200);
+	pascal::check_binomial_properties(200);
+	// Generate, check and draw one row at a time.
+	show_view(std::cout, pascal::RowStream(32) | std::views::transform(check_row));
+	//show_vectors(std::cout, pascal::RowStream(16) | std::views::transform(check_row));
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+#include "exact_triangle.h"
+
+#include <algorithm>
+#include <cassert>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace pascal
+{
+	namespace
+	{
+		template<typename T>
+		constexpr T max_of()
+		{
+			return static_cast<T>(~T{ 0 });
+		}
+
+		// The largest entry of row n + 1 is the sum of the two
+		// centre entries of row n, so checking that sum is enough.
+		template<typename T>
+		bool next_row_fits(const std::vector<T>& row)
+		{
+			if (row.size() < 2) {
+				return true;
+			}
+			const std::size_t centre = row.size() / 2;
+			return row[centre] <= max_of<T>() - row[centre - 1];
+		}
+
+		// Right to left, so each entry still sees the old value
+		// to its left.
+		template<typename T>
+		void add_adjacent_in_place(std::vector<T>& row)
+		{
+			row.emplace_back(1);
+			for (std::size_t k = row.size() - 2; k > 0; --k) {
+				row[k] += row[k - 1];
+			}
+		}
+
+		BigUint to_big(std::uint64_t value)
+		{
+			return BigUint(value);
+		}
+
+#if defined(__SIZEOF_INT128__)
+		BigUint to_big(uint128 value)
+		{
+			return BigUint::from_limbs({
+				static_cast<std::uint64_t>(value),
+				static_cast<std::uint64_t>(value >> 64) });
+		}
+#endif
+
+		BigUint to_big(const BigUint& value)
+		{
+			return value;
+		}
+
+		template<typename To, typename From>
+		std::vector<To> widen(const std::vector<From>& row)
+		{
+			std::vector<To> wider;
+			wider.reserve(row.size() + 1);
+			for (const auto& value : row) {
+				if constexpr (std::is_same_v<To, BigUint>) {
+					wider.push_back(to_big(value));
+				}
+				else {
+					wider.push_back(static_cast<To>(value));
+				}
+			}
+			return wider;
+		}
+	}
+
+	BigUint::BigUint(std::uint64_t value)
+	{
+		if (value) {
+			limbs_.push_back(value);
+		}
+	}
+
+	BigUint BigUint::from_limbs(std::vector<std::uint64_t> limbs)
+	{
+		while (!limbs.empty() && limbs.back() == 0) {
+			limbs.pop_back();
+		}
+		BigUint result;
+		result.limbs_ = std::move(limbs);
+		return result;
+	}
+
+	BigUint BigUint::power_of_two(std::size_t exponent)
+	{
+		std::vector<std::uint64_t> limbs(exponent / 64 + 1, 0);
+		limbs.back() = std::uint64_t{ 1 } << (exponent % 64);
+		return from_limbs(std::move(limbs));
+	}
+
+	BigUint& BigUint::operator+=(const BigUint& other)
+	{
+		const std::size_t other_size = other.limbs_.size();
+		if (limbs_.size() < other_size) {
+			limbs_.resize(other_size, 0);
+		}
+		std::uint64_t carry = 0;
+		std::size_t i = 0;
+		for (; i < other_size; ++i) {
+			std::uint64_t sum = limbs_[i] + carry;
+			carry = sum < carry;
+			sum += other.limbs_[i];
+			carry += sum < other.limbs_[i];
+			limbs_[i] = sum;
+		}
+		for (; carry && i < limbs_.size(); ++i) {
+			carry = ++limbs_[i] == 0;
+		}
+		if (carry) {
+			limbs_.push_back(carry);
+		}
+		return *this;
+	}
+
+	std::strong_ordering BigUint::operator<=>(const BigUint& other) const
+	{
+		if (auto cmp = limbs_.size() <=> other.limbs_.size(); cmp != 0) {
+			return cmp;
+		}
+		return std::lexicographical_compare_three_way(
+			limbs_.rbegin(), limbs_.rend(),
+			other.limbs_.rbegin(), other.limbs_.rend());
+	}
+
+	std::string BigUint::to_string() const
+	{
+		if (limbs_.empty()) {
+			return "0";
+		}
+		// Long division by 10^9 over 32-bit halves keeps every
+		// intermediate value inside 64 bits.
+		std::vector<std::uint32_t> halves;
+		for (auto limb : limbs_) {
+			halves.push_back(static_cast<std::uint32_t>(limb));
+			halves.push_back(static_cast<std::uint32_t>(limb >> 32));
+		}
+		constexpr std::uint64_t base = 1'000'000'000;
+		std::vector<std::uint32_t> chunks;
+		while (!halves.empty()) {
+			std::uint64_t remainder = 0;
+			for (std::size_t i = halves.size(); i-- > 0;) {
+				std::uint64_t current = (remainder << 32) | halves[i];
+				halves[i] = static_cast<std::uint32_t>(current / base);
+				remainder = current % base;
+			}
+			chunks.push_back(static_cast<std::uint32_t>(remainder));
+			while (!halves.empty() && halves.back() == 0) {
+				halves.pop_back();
+			}
+		}
+		std::string result = std::to_string(chunks.back());
+		for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+			auto digits = std::to_string(chunks[i]);
+			result.append(9 - digits.size(), '0');
+			result += digits;
+		}
+		return result;
+	}
+
+	ExactRow::ExactRow() : row_(std::vector<std::uint64_t>{ 1 })
+	{
+	}
+
+	void ExactRow::advance()
+	{
+		if (auto* row = std::get_if<std::vector<std::uint64_t>>(&row_)) {
+			if (next_row_fits(*row)) {
+				add_adjacent_in_place(*row);
+				return;
+			}
+#if defined(__SIZEOF_INT128__)
+			row_ = widen<uint128>(*row);
+#else
+			row_ = widen<BigUint>(*row);
+#endif
+		}
+#if defined(__SIZEOF_INT128__)
+		if (auto* row = std::get_if<std::vector<uint128>>(&row_)) {
+			if (next_row_fits(*row)) {
+				add_adjacent_in_place(*row);
+				return;
+			}
+			row_ = widen<BigUint>(*row);
+		}
+#endif
+		add_adjacent_in_place(std::get<std::vector<BigUint>>(row_));
+	}
+
+	std::size_t ExactRow::index() const
+	{
+		return std::visit([](const auto& row) { return row.size() - 1; }, row_);
+	}
+
+	RowWidth ExactRow::width() const
+	{
+		if (std::holds_alternative<std::vector<std::uint64_t>>(row_)) {
+			return RowWidth::Bits64;
+		}
+		if (std::holds_alternative<std::vector<BigUint>>(row_)) {
+			return RowWidth::Unbounded;
+		}
+		return RowWidth::Bits128;
+	}
+
+	BigUint ExactRow::at(std::size_t k) const
+	{
+		return std::visit([k](const auto& row) { return to_big(row.at(k)); }, row_);
+	}
+
+	std::vector<BigUint> ExactRow::values() const
+	{
+		return std::visit([](const auto& row) { return widen<BigUint>(row); }, row_);
+	}
+
+	std::vector<BigUint> exact_row(std::size_t n)
+	{
+		ExactRow row;
+		while (row.index() < n) {
+			row.advance();
+		}
+		return row.values();
+	}
+
+	void check_exact_properties(std::size_t rows)
+	{
+		ExactRow row;
+		for (std::size_t n = 0; n < rows; ++n, row.advance()) {
+			auto values = row.values();
+			assert(values.size() == n + 1);
+			assert(values.front() == BigUint(1));
+			assert(values.back() == BigUint(1));
+			BigUint total;
+			for (const auto& value : values) {
+				total += value;
+			}
+			assert(total == BigUint::power_of_two(n));
+			assert(std::ranges::equal(values, values | std::views::reverse));
+		}
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace pascal
+{
+#if defined(__SIZEOF_INT128__)
+	using uint128 = unsigned __int128;
+#endif
+
+	// Unsigned integer of any size, stored as 64-bit limbs
+	// with the least significant limb first.
+	class BigUint
+	{
+	public:
+		BigUint() = default;
+		explicit BigUint(std::uint64_t value);
+
+		BigUint& operator+=(const BigUint& other);
+		bool operator==(const BigUint&) const = default;
+		std::strong_ordering operator<=>(const BigUint& other) const;
+
+		static BigUint from_limbs(std::vector<std::uint64_t> limbs);
+		static BigUint power_of_two(std::size_t exponent);
+
+		const std::vector<std::uint64_t>& limbs() const { return limbs_; }
+		std::string to_string() const;
+	private:
+		std::vector<std::uint64_t> limbs_;
+	};
+
+	enum class RowWidth
+	{
+		Bits64,
+		Bits128,
+		Unbounded
+	};
+
+	// One row of Pascal's triangle, updated in place.
+	// Starts with 64-bit values and moves to wider storage
+	// only when the next row would overflow.
+	class ExactRow
+	{
+	public:
+		ExactRow();
+
+		void advance();
+		std::size_t index() const;
+		std::size_t size() const { return index() + 1; }
+		RowWidth width() const;
+
+		BigUint at(std::size_t k) const;
+		std::vector<BigUint> values() const;
+	private:
+		std::variant<
+			std::vector<std::uint64_t>,
+#if defined(__SIZEOF_INT128__)
+			std::vector<uint128>,
+#endif
+			std::vector<BigUint>> row_;
+	};
+
+	std::vector<BigUint> exact_row(std::size_t n);
+
+	void check_exact_properties(std::size_t rows);
+}
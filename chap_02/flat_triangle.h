@@ -0,0 +1,125 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace pascal
+{
+	constexpr std::size_t row_offset(std::size_t row)
+	{
+		return row * (row + 1) / 2;
+	}
+
+	constexpr std::size_t triangle_size(std::size_t rows)
+	{
+		return row_offset(rows);
+	}
+
+	// Walks the rows of a flat triangle, handing out each row as a span.
+	template<typename T>
+	class RowIterator
+	{
+	public:
+		using value_type = std::span<T>;
+		using difference_type = std::ptrdiff_t;
+		using iterator_concept = std::random_access_iterator_tag;
+
+		RowIterator() = default;
+		RowIterator(T* base, std::size_t row) : base_(base), row_(row)
+		{
+		}
+
+		std::span<T> operator*() const
+		{
+			return { base_ + row_offset(row_), row_ + 1 };
+		}
+		std::span<T> operator[](difference_type n) const
+		{
+			return *(*this + n);
+		}
+
+		RowIterator& operator++() { ++row_; return *this; }
+		RowIterator operator++(int) { auto old = *this; ++row_; return old; }
+		RowIterator& operator--() { --row_; return *this; }
+		RowIterator operator--(int) { auto old = *this; --row_; return old; }
+		RowIterator& operator+=(difference_type n) { row_ += n; return *this; }
+		RowIterator& operator-=(difference_type n) { row_ -= n; return *this; }
+
+		friend RowIterator operator+(RowIterator it, difference_type n) { return it += n; }
+		friend RowIterator operator+(difference_type n, RowIterator it) { return it += n; }
+		friend RowIterator operator-(RowIterator it, difference_type n) { return it -= n; }
+		friend difference_type operator-(const RowIterator& lhs, const RowIterator& rhs)
+		{
+			return static_cast<difference_type>(lhs.row_) - static_cast<difference_type>(rhs.row_);
+		}
+
+		bool operator==(const RowIterator&) const = default;
+		auto operator<=>(const RowIterator&) const = default;
+	private:
+		T* base_ = nullptr;
+		std::size_t row_ = 0;
+	};
+
+	// Pascal's triangle in a single buffer of n(n+1)/2 values.
+	// Row r starts at offset r(r+1)/2 and holds r + 1 values.
+	template<typename T = int>
+	class FlatTriangle
+	{
+	public:
+		explicit FlatTriangle(std::size_t rows) :
+			rows_(rows),
+			data_(triangle_size(rows))
+		{
+		}
+
+		std::size_t size() const { return rows_; }
+		bool empty() const { return rows_ == 0; }
+
+		std::span<T> operator[](std::size_t row)
+		{
+			return { data_.data() + row_offset(row), row + 1 };
+		}
+		std::span<const T> operator[](std::size_t row) const
+		{
+			return { data_.data() + row_offset(row), row + 1 };
+		}
+
+		std::span<T> front() { return (*this)[0]; }
+		std::span<const T> front() const { return (*this)[0]; }
+		std::span<T> back() { return (*this)[rows_ - 1]; }
+		std::span<const T> back() const { return (*this)[rows_ - 1]; }
+
+		RowIterator<T> begin() { return { data_.data(), 0 }; }
+		RowIterator<T> end() { return { data_.data(), rows_ }; }
+		RowIterator<const T> begin() const { return { data_.data(), 0 }; }
+		RowIterator<const T> end() const { return { data_.data(), rows_ }; }
+
+		std::span<T> values() { return data_; }
+		std::span<const T> values() const { return data_; }
+	private:
+		std::size_t rows_;
+		std::vector<T> data_;
+	};
+
+	template<typename T = int>
+	FlatTriangle<T> generate_flat_triangle(std::size_t rows)
+	{
+		FlatTriangle<T> triangle(rows);
+		for (std::size_t n = 0; n < rows; ++n) {
+			auto row = triangle[n];
+			row.front() = 1;
+			row.back() = 1;
+			if (n < 2) {
+				continue;
+			}
+			auto last_row = triangle[n - 1];
+			for (std::size_t k = 1; k < n; ++k) {
+				row[k] = last_row[k - 1] + last_row[k];
+			}
+		}
+		return triangle;
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <ranges>
+#include <string>
+#include <string_view>
+
+namespace pascal
+{
+	// Builds a whole triangle's text in one reused buffer and writes it
+	// with a single call. Output matches show_vectors and show_view.
+	class Frame
+	{
+	public:
+		explicit Frame(std::size_t capacity = 0)
+		{
+			buffer_.reserve(capacity);
+		}
+
+		template<std::ranges::input_range Rows>
+			requires std::ranges::sized_range<Rows>
+		Frame& vectors(Rows&& rows)
+		{
+			const std::size_t final_row_size = std::ranges::size(rows);
+			buffer_.reserve(buffer_.size() + final_row_size * (final_row_size * 9 + 1));
+			std::size_t indent = final_row_size * 3;
+			for (const auto& row : rows) {
+				buffer_.append(indent, ' ');
+				if (indent > 3) {
+					indent -= 3;
+				}
+				for (const auto& data : row) {
+					append_centred(data, 6);
+				}
+				buffer_ += '\n';
+			}
+			return *this;
+		}
+
+		template<std::ranges::input_range Rows>
+			requires std::ranges::sized_range<Rows>
+		Frame& view(Rows&& rows)
+		{
+			const std::size_t final_row_size = std::ranges::size(rows);
+			buffer_.reserve(buffer_.size() + final_row_size * (final_row_size * 3 + 1));
+			std::size_t indent = final_row_size;
+			for (const auto& row : rows) {
+				buffer_.append(indent, ' ');
+				if (indent) {
+					--indent;
+				}
+				for (const auto& data : row) {
+					buffer_ += data % 2 ? '*' : ' ';
+					buffer_ += ' ';
+				}
+				buffer_ += '\n';
+			}
+			return *this;
+		}
+
+		std::string_view text() const { return buffer_; }
+
+		// Writes everything built so far and empties the buffer,
+		// keeping its capacity for the next frame.
+		void flush(std::ostream& os)
+		{
+			os.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+			buffer_.clear();
+		}
+	private:
+		// Same layout as std::format("{: ^{}}", value, width).
+		template<typename T>
+		void append_centred(T value, std::size_t width)
+		{
+			char digits[24];
+			auto [end, ec] = std::to_chars(std::begin(digits), std::end(digits), value);
+			const std::size_t length = static_cast<std::size_t>(end - digits);
+			const std::size_t padding = length < width ? width - length : 0;
+			buffer_.append(padding / 2, ' ');
+			buffer_.append(digits, length);
+			buffer_.append(padding - padding / 2, ' ');
+		}
+
+		std::string buffer_;
+	};
+}
@@ -0,0 +1,268 @@
+#include "row_kernel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PASCAL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(PASCAL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PASCAL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PASCAL_TARGET(isa)
+#endif
+
+namespace pascal
+{
+	namespace
+	{
+		// Unsigned so that overflow wraps, matching the vector adds.
+		void next_row_scalar(const std::uint32_t* last, std::uint32_t* next, std::size_t n)
+		{
+			for (std::size_t k = 1; k <= n; ++k) {
+				next[k] = last[k - 1] + last[k];
+			}
+		}
+
+		void in_place_scalar(std::uint32_t* row, std::size_t from)
+		{
+			for (std::size_t k = from; k > 0; --k) {
+				row[k] += row[k - 1];
+			}
+		}
+
+#if defined(PASCAL_X86)
+		PASCAL_TARGET("sse2")
+		void next_row_sse2(const std::uint32_t* last, std::uint32_t* next, std::size_t n)
+		{
+			std::size_t k = 1;
+			for (; k + 4 <= n + 1; k += 4) {
+				__m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last + k - 1));
+				__m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last + k));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(next + k), _mm_add_epi32(left, right));
+			}
+			for (; k <= n; ++k) {
+				next[k] = last[k - 1] + last[k];
+			}
+		}
+
+		// Each block loads both inputs before it stores, and the block to
+		// its left only reads values below the block, so nothing is
+		// overwritten before it has been used.
+		PASCAL_TARGET("sse2")
+		void in_place_sse2(std::uint32_t* row, std::size_t from)
+		{
+			std::size_t end = from + 1;
+			for (; end >= 4 + 1; end -= 4) {
+				std::uint32_t* block = row + end - 4;
+				__m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block - 1));
+				__m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(block), _mm_add_epi32(left, right));
+			}
+			in_place_scalar(row, end - 1);
+		}
+
+		PASCAL_TARGET("avx2")
+		void next_row_avx2(const std::uint32_t* last, std::uint32_t* next, std::size_t n)
+		{
+			std::size_t k = 1;
+			for (; k + 8 <= n + 1; k += 8) {
+				__m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last + k - 1));
+				__m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last + k));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(next + k), _mm256_add_epi32(left, right));
+			}
+			for (; k <= n; ++k) {
+				next[k] = last[k - 1] + last[k];
+			}
+		}
+
+		PASCAL_TARGET("avx2")
+		void in_place_avx2(std::uint32_t* row, std::size_t from)
+		{
+			std::size_t end = from + 1;
+			for (; end >= 8 + 1; end -= 8) {
+				std::uint32_t* block = row + end - 8;
+				__m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block - 1));
+				__m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(block), _mm256_add_epi32(left, right));
+			}
+			in_place_scalar(row, end - 1);
+		}
+
+		bool cpu_has_avx2()
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7) {
+				return false;
+			}
+			__cpuid(info, 1);
+			const bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+			__cpuidex(info, 7, 0);
+			return os_saves_ymm && (info[1] & (1 << 5));
+#else
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+
+		bool cpu_has_sse2()
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 1);
+			return info[3] & (1 << 26);
+#else
+			return __builtin_cpu_supports("sse2");
+#endif
+		}
+#endif
+	}
+
+	std::string_view to_string(Kernel kernel)
+	{
+		switch (kernel)
+		{
+		case Kernel::Scalar:
+			return "scalar";
+		case Kernel::SSE2:
+			return "sse2";
+		case Kernel::AVX2:
+			return "avx2";
+		default:
+			return "?";
+		}
+	}
+
+	bool is_supported(Kernel kernel)
+	{
+#if defined(PASCAL_X86)
+		static const bool sse2 = cpu_has_sse2();
+		static const bool avx2 = cpu_has_avx2();
+		switch (kernel)
+		{
+		case Kernel::SSE2:
+			return sse2;
+		case Kernel::AVX2:
+			return avx2;
+		default:
+			break;
+		}
+#endif
+		return kernel == Kernel::Scalar;
+	}
+
+	Kernel best_kernel()
+	{
+		for (auto kernel : { Kernel::AVX2, Kernel::SSE2 }) {
+			if (is_supported(kernel)) {
+				return kernel;
+			}
+		}
+		return Kernel::Scalar;
+	}
+
+	void next_row(Kernel kernel,
+		std::span<const std::uint32_t> last_row,
+		std::span<std::uint32_t> next_row)
+	{
+		assert(next_row.size() == last_row.size() + 1);
+		assert(is_supported(kernel));
+		next_row.front() = 1;
+		next_row.back() = 1;
+		if (last_row.size() < 2) {
+			return;
+		}
+		const std::size_t n = last_row.size() - 1;
+		switch (kernel)
+		{
+#if defined(PASCAL_X86)
+		case Kernel::AVX2:
+			next_row_avx2(last_row.data(), next_row.data(), n);
+			return;
+		case Kernel::SSE2:
+			next_row_sse2(last_row.data(), next_row.data(), n);
+			return;
+#endif
+		default:
+			next_row_scalar(last_row.data(), next_row.data(), n);
+		}
+	}
+
+	// int and std::uint32_t may alias each other, so the int overloads
+	// share the unsigned kernels.
+	void next_row(Kernel kernel,
+		std::span<const int> last_row,
+		std::span<int> next_row)
+	{
+		pascal::next_row(kernel,
+			{ reinterpret_cast<const std::uint32_t*>(last_row.data()), last_row.size() },
+			{ reinterpret_cast<std::uint32_t*>(next_row.data()), next_row.size() });
+	}
+
+	void next_row_in_place(Kernel kernel, std::span<std::uint32_t> row)
+	{
+		assert(!row.empty());
+		assert(is_supported(kernel));
+		row.back() = 1;
+		if (row.size() < 3) {
+			return;
+		}
+		const std::size_t from = row.size() - 2;
+		switch (kernel)
+		{
+#if defined(PASCAL_X86)
+		case Kernel::AVX2:
+			in_place_avx2(row.data(), from);
+			return;
+		case Kernel::SSE2:
+			in_place_sse2(row.data(), from);
+			return;
+#endif
+		default:
+			in_place_scalar(row.data(), from);
+		}
+	}
+
+	void next_row_in_place(Kernel kernel, std::span<int> row)
+	{
+		next_row_in_place(kernel,
+			std::span<std::uint32_t>{ reinterpret_cast<std::uint32_t*>(row.data()), row.size() });
+	}
+
+	void check_kernels(std::size_t rows)
+	{
+		for (auto kernel : { Kernel::Scalar, Kernel::SSE2, Kernel::AVX2 }) {
+			if (!is_supported(kernel)) {
+				continue;
+			}
+			std::vector<std::uint32_t> expected{ 1 };
+			std::vector<std::uint32_t> last{ 1 };
+			std::vector<std::uint32_t> in_place(rows + 1);
+			in_place.front() = 1;
+			for (std::size_t n = 1; n < rows; ++n) {
+				std::vector<std::uint32_t> scalar(n + 1);
+				next_row_scalar(expected.data(), scalar.data(), n - 1);
+				scalar.front() = 1;
+				scalar.back() = 1;
+
+				std::vector<std::uint32_t> next(n + 1);
+				next_row(kernel, last, next);
+				assert(next == scalar);
+
+				next_row_in_place(kernel, std::span(in_place).first(n + 1));
+				assert(std::ranges::equal(std::span(in_place).first(n + 1), scalar));
+
+				expected = std::move(scalar);
+				last = std::move(next);
+			}
+		}
+	}
+}
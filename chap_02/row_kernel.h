@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace pascal
+{
+	enum class Kernel
+	{
+		Scalar,
+		SSE2,
+		AVX2
+	};
+
+	std::string_view to_string(Kernel kernel);
+
+	bool is_supported(Kernel kernel);
+
+	// The widest kernel this CPU can run.
+	Kernel best_kernel();
+
+	// Writes row n + 1 from row n.
+	// next_row must be one longer than last_row.
+	void next_row(Kernel kernel,
+		std::span<const std::uint32_t> last_row,
+		std::span<std::uint32_t> next_row);
+
+	void next_row(Kernel kernel,
+		std::span<const int> last_row,
+		std::span<int> next_row);
+
+	// Turns row n into row n + 1 in place, working right to left.
+	// row holds row n in its first n + 1 values and has room for one more.
+	void next_row_in_place(Kernel kernel, std::span<std::uint32_t> row);
+
+	void next_row_in_place(Kernel kernel, std::span<int> row);
+
+	// Compares every supported kernel against the scalar one.
+	void check_kernels(std::size_t rows);
+}
@@ -0,0 +1,35 @@
+#include "row_stream.h"
+
+#include <utility>
+
+namespace pascal
+{
+	RowStream::RowStream(std::size_t rows, Kernel kernel) :
+		rows_(rows),
+		kernel_(kernel),
+		current_(rows + 1),
+		next_(rows + 1)
+	{
+	}
+
+	RowStream::iterator RowStream::begin()
+	{
+		index_ = 0;
+		current_.front() = 1;
+		return iterator{ this };
+	}
+
+	std::span<const int> RowStream::row() const
+	{
+		return std::span(current_).first(index_ + 1);
+	}
+
+	void RowStream::advance()
+	{
+		if (++index_ >= rows_) {
+			return;
+		}
+		next_row(kernel_, std::span(current_).first(index_), std::span(next_).first(index_ + 1));
+		std::swap(current_, next_);
+	}
+}
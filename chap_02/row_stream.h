@@ -0,0 +1,54 @@
+#pragma once
+
+#include "row_kernel.h"
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace pascal
+{
+	// Yields the rows of Pascal's triangle one at a time from two
+	// reused buffers, so memory is O(rows) rather than O(rows^2).
+	// Each row is only valid until the iterator moves on.
+	class RowStream
+	{
+	public:
+		class iterator
+		{
+		public:
+			using value_type = std::span<const int>;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() = default;
+			explicit iterator(RowStream* stream) : stream_(stream)
+			{
+			}
+
+			std::span<const int> operator*() const { return stream_->row(); }
+			iterator& operator++() { stream_->advance(); return *this; }
+			void operator++(int) { ++*this; }
+			bool operator==(std::default_sentinel_t) const { return stream_->done(); }
+		private:
+			RowStream* stream_ = nullptr;
+		};
+
+		explicit RowStream(std::size_t rows, Kernel kernel = best_kernel());
+
+		// Starts again from the first row.
+		iterator begin();
+		std::default_sentinel_t end() const { return {}; }
+		std::size_t size() const { return rows_; }
+	private:
+		std::span<const int> row() const;
+		void advance();
+		bool done() const { return index_ >= rows_; }
+
+		std::size_t rows_;
+		Kernel kernel_;
+		std::size_t index_ = 0;
+		std::vector<int> current_;
+		std::vector<int> next_;
+	};
+}
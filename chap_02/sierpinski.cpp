@@ -0,0 +1,77 @@
+#include "sierpinski.h"
+
+#include <bit>
+#include <cassert>
+#include <string>
+
+namespace pascal
+{
+	ParityRow::ParityRow() : words_{ 1 }
+	{
+	}
+
+	void ParityRow::advance()
+	{
+		++index_;
+		if (index_ / 64 == words_.size()) {
+			words_.push_back(0);
+		}
+		// High word first, so the carry comes from the old lower word.
+		for (std::size_t i = words_.size() - 1; i > 0; --i) {
+			words_[i] ^= (words_[i] << 1) | (words_[i - 1] >> 63);
+		}
+		words_[0] ^= words_[0] << 1;
+	}
+
+	std::size_t ParityRow::count() const
+	{
+		std::size_t total = 0;
+		for (auto word : words_) {
+			total += std::popcount(word);
+		}
+		return total;
+	}
+
+	void show_sierpinski(std::ostream& os, std::size_t rows)
+	{
+		if (rows == 0) {
+			return;
+		}
+		std::string line;
+		line.reserve(rows + 2 * rows + 1);
+		ParityRow row;
+		for (std::size_t n = 0; n < rows; ++n, row.advance()) {
+			const std::size_t indent = rows - n;
+			line.assign(indent + 2 * row.size(), ' ');
+			const auto& words = row.words();
+			for (std::size_t i = 0; i < words.size(); ++i) {
+				for (auto bits = words[i]; bits; bits &= bits - 1) {
+					line[indent + 2 * (64 * i + std::countr_zero(bits))] = '*';
+				}
+			}
+			line += '\n';
+			os.write(line.data(), static_cast<std::streamsize>(line.size()));
+		}
+	}
+
+	void check_parity_properties(std::size_t rows)
+	{
+		ParityRow row;
+		std::vector<std::uint64_t> values{ 1 };
+		for (std::size_t n = 0; n < rows; ++n, row.advance()) {
+			assert(row.size() == n + 1);
+			assert(row[0] && row[n]);
+			// Glaisher: row n has 2^(set bits of n) odd values.
+			assert(row.count() == std::size_t{ 1 } << std::popcount(n));
+			if (n < 64) {
+				for (std::size_t k = 0; k <= n; ++k) {
+					assert(row[k] == (values[k] % 2 == 1));
+				}
+				values.push_back(1);
+				for (std::size_t k = values.size() - 2; k > 0; --k) {
+					values[k] += values[k - 1];
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace pascal
+{
+	// The parity of each value in one row of Pascal's triangle,
+	// packed 64 cells to a word with cell k in bit k % 64 of word k / 64.
+	class ParityRow
+	{
+	public:
+		ParityRow();
+
+		// Row n + 1 is row n ^ (row n << 1).
+		void advance();
+		std::size_t index() const { return index_; }
+		std::size_t size() const { return index_ + 1; }
+
+		bool operator[](std::size_t k) const
+		{
+			return (words_[k / 64] >> (k % 64)) & 1;
+		}
+		std::size_t count() const;
+		const std::vector<std::uint64_t>& words() const { return words_; }
+	private:
+		std::vector<std::uint64_t> words_;
+		std::size_t index_ = 0;
+	};
+
+	// Same layout as show_view, streamed one row at a time
+	// so only the current row and line are held in memory.
+	void show_sierpinski(std::ostream& os, std::size_t rows);
+
+	void check_parity_properties(std::size_t rows);
+}
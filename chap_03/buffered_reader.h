@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace input
+{
+	// Reads an istream a large block at a time and parses straight
+	// out of the block, for replaying recorded sessions quickly.
+	// Each read blocks until the block is full or the input ends,
+	// so this is for files and pipes rather than a live terminal.
+	// Views it hands out last until the next call.
+	class BufferedReader
+	{
+	public:
+		explicit BufferedReader(std::istream& in, std::size_t block_size = 1 << 16) :
+			in_(in),
+			buffer_(std::max<std::size_t>(block_size, 1))
+		{
+		}
+
+		// True once only whitespace is left.
+		bool done()
+		{
+			return !skip_whitespace();
+		}
+
+		std::optional<std::string_view> next_token()
+		{
+			if (!skip_whitespace()) {
+				return {};
+			}
+			std::size_t stop = find_from(pos_, [](char c) { return is_space(c); });
+			std::string_view token(buffer_.data() + pos_, stop - pos_);
+			pos_ = stop;
+			return token;
+		}
+
+		// The next line without its '\n', like std::getline.
+		std::optional<std::string_view> next_line()
+		{
+			if (pos_ == end_ && !refill()) {
+				return {};
+			}
+			std::size_t stop = find_from(pos_, [](char c) { return c == '\n'; });
+			std::string_view line(buffer_.data() + pos_, stop - pos_);
+			pos_ = stop < end_ ? stop + 1 : stop;
+			return line;
+		}
+
+		// Behaves like `in >> value`: skips whitespace, reads one int and
+		// leaves anything after its digits for the next read. On failure
+		// it drops the rest of the line and returns nothing.
+		std::optional<int> read_number()
+		{
+			auto token = next_token();
+			if (!token) {
+				return {};
+			}
+			std::string_view digits = *token;
+			if (digits.size() > 1 && digits.front() == '+' && digits[1] != '-') {
+				digits.remove_prefix(1);
+			}
+			int value{};
+			auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+			if (ec != std::errc{}) {
+				pos_ -= token->size();
+				skip_line();
+				return {};
+			}
+			pos_ -= static_cast<std::size_t>(digits.data() + digits.size() - end);
+			return value;
+		}
+	private:
+		static bool is_space(char c)
+		{
+			return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+		}
+
+		// Moves what is left to the front and reads more after it,
+		// growing the buffer if it is already full.
+		bool refill()
+		{
+			if (pos_ > 0) {
+				std::copy(buffer_.begin() + pos_, buffer_.begin() + end_, buffer_.begin());
+				end_ -= pos_;
+				pos_ = 0;
+			}
+			if (end_ == buffer_.size()) {
+				buffer_.resize(buffer_.size() * 2);
+			}
+			in_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+			const auto got = static_cast<std::size_t>(in_.gcount());
+			end_ += got;
+			return got > 0;
+		}
+
+		bool skip_whitespace()
+		{
+			while (true) {
+				while (pos_ < end_ && is_space(buffer_[pos_])) {
+					++pos_;
+				}
+				if (pos_ < end_) {
+					return true;
+				}
+				if (!refill()) {
+					return false;
+				}
+			}
+		}
+
+		void skip_line()
+		{
+			std::size_t stop = find_from(pos_, [](char c) { return c == '\n'; });
+			pos_ = stop < end_ ? stop + 1 : stop;
+		}
+
+		// The index of the first match at or after from, reading more
+		// as needed; end_ if the input runs out first.
+		template<typename Match>
+		std::size_t find_from(std::size_t from, Match match)
+		{
+			std::size_t offset = from - pos_;
+			while (true) {
+				auto first = buffer_.begin() + pos_ + offset;
+				auto found = std::find_if(first, buffer_.begin() + end_, match);
+				offset = static_cast<std::size_t>(found - buffer_.begin()) - pos_;
+				if (found != buffer_.begin() + end_ || !refill()) {
+					return pos_ + offset;
+				}
+			}
+		}
+
+		std::istream& in_;
+		std::vector<char> buffer_;
+		std::size_t pos_ = 0;
+		std::size_t end_ = 0;
+	};
+}
@@ -1,12 +1,28 @@
+#include "buffered_reader.h"
+#include "clue_chain.h"
+#include "clues.h"
+#include "game_primes.h"
+#include "miller_rabin.h"
+#include "prime_table.h"
+#include "solver.h"
+
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
 #include <format>
 #include <functional>
 #include <iostream>
 #include <istream>
+#include <iterator>
 #include <limits>
 #include <optional>
 #include <random>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 std::optional<int> read_number(std::istream& is) {
@@ -19,7 +35,18 @@ std::optional<int> read_number(std::istream& is) {
 	return {};
 }
 
-constexpr bool is_prime(int n) {
+std::optional<int> read_number(input::BufferedReader& reader) {
+	return reader.read_number();
+}
+
+using primes::game_limit;
+
+const primes::PrimeTable& prime_table() {
+	static const primes::PrimeTable table(game_limit);
+	return table;
+}
+
+constexpr bool is_prime_by_trial_division(int n) {
 
 	if (n == 2 || n == 3) {
 		return true;
@@ -29,8 +56,9 @@ constexpr bool is_prime(int n) {
 		return false;
 	}
 
-	for (int i = 5; i * i <= n; ++i) {
-		if (n % i == 0) {
+	// Only 6k - 1 and 6k + 1 can be prime divisors once 2 and 3 are ruled out.
+	for (int i = 5; i * i <= n; i += 6) {
+		if (n % i == 0 || n % (i + 2) == 0) {
 			return false;
 		}
 	}
@@ -38,18 +66,116 @@ constexpr bool is_prime(int n) {
 	return true;
 }
 
-int some_prime_number() {
-	std::random_device rd;
-	std::mt19937 engine(rd());
-	std::uniform_int_distribution<int> dist(1, 99999);
-	int n{};
-	while (!is_prime(n)) {
-		n = dist(engine);
+constexpr bool is_prime(int n) {
+	if (n < 0) {
+		return false;
 	}
-	return n;
+	if (!std::is_constant_evaluated() && n <= game_limit) {
+		return prime_table().is_prime(static_cast<std::uint64_t>(n));
+	}
+	return primes::is_prime(static_cast<std::uint64_t>(n));
+}
+
+int some_prime_number() {
+	static std::mt19937 engine{ std::random_device{}() };
+	std::uniform_int_distribution<size_t> index(0, primes::game_primes.size() - 1);
+	return primes::game_primes[index(engine)];
 }
 
+// number and guess are from 0 to 99999.
 std::string check_which_digits_correct(int number, int guess) {
+	return clues::to_string(clues::score(clues::to_digits(number), clues::to_digits(guess)));
+}
+
+void show_clue(std::ostream& os, std::ranges::range auto& messages, int guess) {
+	for (auto& message : messages) {
+		auto clue = message(guess);
+		if (clue.length()) {
+			os << clue;
+			break;
+		}
+	}
+}
+
+template <typename... Checks>
+void show_clue(std::ostream& os, clues::ClueChain<Checks...>& messages, int guess) {
+	os << messages(guess);
+}
+
+// Returns how many guesses were read.
+int guess_number_with_more_clues(int number, auto& messages, auto& input, std::ostream& os) {
+	os << "Guess the number.\n>";
+	int guesses = 0;
+	std::optional<int> guess;
+	while (guess = read_number(input))
+	{
+		++guesses;
+		if (guess.value() == number) {
+			os << "Well done.\n";
+			return guesses;
+		}
+		std::format_to(std::ostreambuf_iterator<char>(os),
+			"{:0>5} is wrong. Try again.\n", guess.value());
+		show_clue(os, messages, guess.value());
+	}
+	os << std::format("The number was {}.\n", number);
+	return guesses;
+}
+
+void guess_number_with_more_clues(int number, auto messages) {
+	guess_number_with_more_clues(number, messages, std::cin, std::cout);
+}
+
+// Length, then primality, then digits; the first check with
+// something to say gives the clue.
+auto make_clue_chain(int number) {
+	auto check_length = [](int guess) {
+		return std::string_view((guess < 100000) ? "" : "Too long.\n");
+		};
+	auto check_prime = [](int guess) {
+		return std::string_view((is_prime(guess)) ? "" : "Not prime.\n");
+		};
+	auto check_digits = [number, line = std::array<char, 6>{ '.', '.', '.', '.', '.', '\n' }](int guess) mutable {
+		clues::write_marks(clues::score(clues::to_digits(number), clues::to_digits(guess)),
+			std::span(line).first<5>());
+		return std::string_view(line.data(), line.size());
+		};
+	return clues::ClueChain(check_length, check_prime, check_digits);
+}
+
+void check_properties() {
+	static_assert(is_prime(2));
+	static_assert(!is_prime(25));
+	static_assert(primes::game_primes.front() == 2);
+	static_assert(primes::game_primes.back() == 99991);
+	static_assert(primes::is_prime(18'446'744'073'709'551'557u));
+	static_assert(!primes::is_prime(3'825'123'056'546'413'051u));
+	for (int n = 0; n <= 1000; ++n) {
+		assert(is_prime(n) == is_prime_by_trial_division(n));
+	}
+	assert(check_which_digits_correct(12345, 53421) == "^^^^^");
+	static_assert(clues::score(clues::to_digits(12345), clues::to_digits(12345)) == clues::all_correct);
+	static_assert(clues::mark_at(clues::score(clues::to_digits(11222), clues::to_digits(21000)), 0) == clues::Mark::Misplaced);
+}
+
+// The original trial division, stepping through every i.
+constexpr bool is_prime_checking_every_divisor(int n) {
+	if (n == 2 || n == 3) {
+		return true;
+	}
+	if (n <= 1 || n % 2 == 0 || n % 3 == 0) {
+		return false;
+	}
+	for (int i = 5; i * i <= n; ++i) {
+		if (n % i == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// The original string-based scorer.
+std::string check_which_digits_correct_by_string(int number, int guess) {
 	auto ns = std::format("{:0>5}", number);
 	auto gs = std::format("{:0>5}", guess);
 	std::string matches(5, '.');
@@ -73,45 +199,216 @@ std::string check_which_digits_correct(int number, int guess) {
 	return matches;
 }
 
-void guess_number_with_more_clues(int number, auto messages) {
-	std::cout << "Guess the number.\n>";
-	std::optional<int> guess;
-	while (guess = read_number(std::cin))
-	{
-		if (guess.value() == number) {
-			std::cout << "Well done.\n";
-			return;
-		}
-		std::cout << std::format("{:0>5} is wrong. Try again.\n", guess.value());
-		for (auto message : messages) {
-			auto clue = message(guess.value());
-			if (clue.length()) {
-				std::cout << clue;
-				break;
-			}
-		}
+// The original sampler, with a fresh engine and rejection each call.
+int some_prime_number_by_rejection() {
+	std::random_device rd;
+	std::mt19937 engine(rd());
+	std::uniform_int_distribution<int> dist(1, game_limit);
+	int n{};
+	while (!is_prime(n)) {
+		n = dist(engine);
 	}
-	std::cout << std::format("The number was {}.\n", number);
+	return n;
 }
 
-void check_properties() {
-	static_assert(is_prime(2));
-	assert(check_which_digits_correct(12345, 53421) == "^^^^^");
+template <typename F>
+double seconds_taken(F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
 }
 
-int main() {
-	check_properties();
+void benchmark_primes(std::ostream& os) {
+	os << std::format("{:>28} {:>14} {:>14}\n", "method", "limit", "primes/sec");
+	// Known values of pi(x), the number of primes up to x.
+	auto report = [&os](std::string_view name, std::uint64_t limit, std::uint64_t expected, auto count_primes) {
+		std::uint64_t count = 0;
+		double taken = seconds_taken([&] { count = count_primes(limit); });
+		assert(count == expected);
+		os << std::format("{:>28} {:>14} {:>14.0f}\n", name, limit, count / taken);
+	};
+	auto by = [](auto test) {
+		return [test](std::uint64_t limit) {
+			std::uint64_t count = 0;
+			for (int n = 0; n <= static_cast<int>(limit); ++n) {
+				count += test(n);
+			}
+			return count;
+		};
+	};
+	report("every divisor (original)", 10'000'000, 664'579, by(is_prime_checking_every_divisor));
+	report("6k +/- 1 trial division", 10'000'000, 664'579, by(is_prime_by_trial_division));
+	report("Miller-Rabin", 10'000'000, 664'579, by([](int n) {
+		return primes::is_prime(static_cast<std::uint64_t>(n));
+		}));
+	report("PrimeTable", 1'000'000'000, 50'847'534, [](std::uint64_t limit) {
+		return primes::PrimeTable(limit).count();
+		});
+	report("count_primes", std::uint64_t{ 1 } << 32, 203'280'221, [](std::uint64_t limit) {
+		return primes::count_primes(limit);
+		});
+}
+
+void benchmark_clues(std::ostream& os) {
+	const auto& candidates = primes::game_primes;
+	const clues::CandidateSet set(candidates);
+	std::vector<clues::ClueCode> codes(candidates.size());
+	const int guess = 12347;
+	const auto guess_digits = clues::to_digits(guess);
+
+	set.score(guess_digits, codes);
+	for (size_t i = 0; i < candidates.size(); ++i) {
+		assert(clues::to_string(codes[i]) == check_which_digits_correct_by_string(candidates[i], guess));
+	}
+
+	constexpr int rounds = 100;
+	const double scored = static_cast<double>(rounds) * candidates.size();
+	os << std::format("{:>28} {:>14}\n", "scorer", "scores/sec");
+	auto report = [&](std::string_view name, auto score_all) {
+		double taken = seconds_taken([&] {
+			for (int round = 0; round < rounds; ++round) {
+				score_all();
+			}
+			});
+		os << std::format("{:>28} {:>14.0f}\n", name, scored / taken);
+	};
+	report("string (original)", [&] {
+		for (size_t i = 0; i < candidates.size(); ++i) {
+			codes[i] = static_cast<clues::ClueCode>(check_which_digits_correct_by_string(candidates[i], guess).size());
+		}
+		});
+	report("clues::score", [&] {
+		for (size_t i = 0; i < candidates.size(); ++i) {
+			codes[i] = clues::score(clues::to_digits(candidates[i]), guess_digits);
+		}
+		});
+	report("CandidateSet::score", [&] { set.score(guess_digits, codes); });
+}
+
+// The original clue list, built from type-erased checks returning strings.
+std::vector<std::function<std::string(int)>> make_clue_functions(int number) {
 	auto check_prime = [](int guess) {
 		return std::string((is_prime(guess)) ? "" : "Not prime.\n");
 		};
 	auto check_length = [](int guess) {
 		return std::string((guess < 100000) ? "" : "Too long.\n");
 		};
-	const int number = some_prime_number();
 	auto check_digits = [number](int guess) {
 		return std::format("{}\n", check_which_digits_correct(number, guess));
 		};
-	std::vector<std::function<std::string(int)>> messages{ check_length, check_prime, check_digits };
-	guess_number_with_more_clues(number, messages);
+	return { check_length, check_prime, check_digits };
+}
+
+void benchmark_clue_chain(std::ostream& os) {
+	const int number = primes::game_primes[1234];
+	std::mt19937 engine{ 42 };
+	std::uniform_int_distribution<int> dist(0, 2 * game_limit);
+	std::vector<int> guesses(100'000);
+	for (auto& guess : guesses) {
+		guess = dist(engine);
+	}
+
+	auto functions = make_clue_functions(number);
+	auto chain = make_clue_chain(number);
+	for (int guess : guesses) {
+		std::string expected;
+		for (auto& message : functions) {
+			if (expected = message(guess); !expected.empty()) {
+				break;
+			}
+		}
+		assert(chain(guess) == expected);
+	}
+
+	os << std::format("{:>28} {:>14}\n", "clue checks", "ns/guess");
+	auto report = [&](std::string_view name, auto first_clue) {
+		size_t total = 0;
+		double taken = seconds_taken([&] {
+			for (int guess : guesses) {
+				total += first_clue(guess);
+			}
+			});
+		assert(total > 0);
+		os << std::format("{:>28} {:>14.1f}\n", name, taken * 1e9 / guesses.size());
+	};
+	report("vector<std::function>", [&](int guess) {
+		for (auto& message : functions) {
+			if (auto clue = message(guess); clue.length()) {
+				return clue.length();
+			}
+		}
+		return size_t{ 0 };
+		});
+	report("ClueChain", [&](int guess) { return chain(guess).length(); });
+}
+
+void benchmark_sampling(std::ostream& os) {
+	constexpr int draws = 100'000;
+	os << std::format("{:>28} {:>14}\n", "sampler", "ns/draw");
+	auto report = [&os](std::string_view name, auto sample) {
+		double taken = seconds_taken([&] {
+			for (int i = 0; i < draws; ++i) {
+				sample();
+			}
+			});
+		os << std::format("{:>28} {:>14.1f}\n", name, taken * 1e9 / draws);
+	};
+	report("rejection (original)", some_prime_number_by_rejection);
+	report("constexpr table", some_prime_number);
+}
+
+void report_solvers(std::ostream& os) {
+	const unsigned threads = std::max(std::thread::hardware_concurrency(), 1u);
+	os << std::format("Solving all {} primes on {} threads\n", primes::game_primes.size(), threads);
+	for (auto strategy : { solver::Strategy::FirstCandidate, solver::Strategy::Minimax, solver::Strategy::Entropy }) {
+		const solver::Solver solver(primes::game_primes, strategy);
+		const auto report = solver.play_all(threads);
+		os << std::format("{:>16}: mean {:.3f}, worst {}, {:.0f} games/sec\n",
+			solver::to_string(strategy), report.mean(), report.worst(), report.games_per_second());
+		for (size_t guesses = 1; guesses < report.guess_counts.size(); ++guesses) {
+			os << std::format("{:>20} guesses: {}\n", guesses, report.guess_counts[guesses]);
+		}
+	}
+}
+
+// Plays recorded guesses from stdin against one secret, starting a new
+// game each time it is found, and reports the rate on stderr.
+void replay_sessions(int number) {
+	std::ios::sync_with_stdio(false);
+	input::BufferedReader reader(std::cin);
+	auto messages = make_clue_chain(number);
+	long long games = 0;
+	long long turns = 0;
+	double taken = seconds_taken([&] {
+		while (!reader.done()) {
+			turns += guess_number_with_more_clues(number, messages, reader, std::cout);
+			++games;
+		}
+		});
+	std::cout.flush();
+	std::cerr << std::format("{} games, {} turns, {:.0f} turns/sec\n",
+		games, turns, taken > 0 ? turns / taken : 0.0);
+}
+
+int main(int argc, char* argv[]) {
+	if (argc > 1 && std::string_view(argv[1]) == "--bench") {
+		benchmark_sampling(std::cout);
+		benchmark_clues(std::cout);
+		benchmark_clue_chain(std::cout);
+		benchmark_primes(std::cout);
+		return 0;
+	}
+	if (argc > 1 && std::string_view(argv[1]) == "--solve") {
+		report_solvers(std::cout);
+		return 0;
+	}
+	if (argc > 2 && std::string_view(argv[1]) == "--replay") {
+		replay_sessions(std::stoi(argv[2]));
+		return 0;
+	}
+	check_properties();
+	const int number = some_prime_number();
+	guess_number_with_more_clues(number, make_clue_chain(number));
 }
 
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace clues
+{
+	// A fixed list of checks, each taking a guess and returning a
+	// std::string_view that is empty when it has nothing to say.
+	// The checks are called in order until one has a clue, all through
+	// the tuple, so there is no type erasure and nothing to allocate.
+	template<typename... Checks>
+	class ClueChain
+	{
+	public:
+		explicit ClueChain(Checks... checks) : checks_(std::move(checks)...)
+		{
+		}
+
+		std::string_view operator()(int guess)
+		{
+			std::string_view clue;
+			std::apply([&](auto&... check) {
+				((clue = check(guess)).empty() && ...);
+				}, checks_);
+			return clue;
+		}
+	private:
+		std::tuple<Checks...> checks_;
+	};
+}
@@ -0,0 +1,123 @@
+#include "clues.h"
+
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLUES_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace clues
+{
+	namespace
+	{
+		// score() without branches, so each candidate is a lane.
+		// Guess digit i is misplaced when it is not exact and, counting
+		// only non-exact positions, its rank among equal guess digits up
+		// to i is at most the number of equal digits left in the number.
+		ClueCode score_lane(const Digits& guess, const std::array<std::uint8_t, 5>& number)
+		{
+			std::array<std::uint8_t, 5> exact{};
+			for (std::size_t i = 0; i < 5; ++i) {
+				exact[i] = guess[i] == number[i];
+			}
+			ClueCode code = 0;
+			for (std::size_t i = 0; i < 5; ++i) {
+				std::uint8_t available = 0, rank = 0;
+				for (std::size_t j = 0; j < 5; ++j) {
+					available += (number[j] == guess[i]) & !exact[j];
+					rank += (j <= i) & (guess[j] == guess[i]) & !exact[j];
+				}
+				const ClueCode mark = exact[i] ? 2 : (rank <= available);
+				code |= mark << (2 * i);
+			}
+			return code;
+		}
+
+#if defined(CLUES_SSE2)
+		// Sixteen candidates at a time, using the same rule as score_lane.
+		void score_sse2(const Digits& guess,
+			const std::array<const std::uint8_t*, 5>& columns,
+			ClueCode* results)
+		{
+			const __m128i one = _mm_set1_epi8(1);
+			__m128i number[5], exact[5];
+			for (std::size_t j = 0; j < 5; ++j) {
+				number[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns[j]));
+				exact[j] = _mm_cmpeq_epi8(number[j], _mm_set1_epi8(static_cast<char>(guess[j])));
+			}
+			__m128i marks[5];
+			for (std::size_t i = 0; i < 5; ++i) {
+				const __m128i digit = _mm_set1_epi8(static_cast<char>(guess[i]));
+				__m128i available = _mm_setzero_si128();
+				__m128i rank = _mm_setzero_si128();
+				for (std::size_t j = 0; j < 5; ++j) {
+					// Compare results are 0 or -1, so subtracting counts them.
+					available = _mm_sub_epi8(available,
+						_mm_andnot_si128(exact[j], _mm_cmpeq_epi8(number[j], digit)));
+					if (j <= i && guess[j] == guess[i]) {
+						rank = _mm_sub_epi8(rank, _mm_andnot_si128(exact[j], _mm_set1_epi8(-1)));
+					}
+				}
+				const __m128i misplaced = _mm_and_si128(one,
+					_mm_cmpeq_epi8(_mm_min_epu8(rank, available), rank));
+				const __m128i correct = _mm_and_si128(exact[i], _mm_set1_epi8(2));
+				marks[i] = _mm_or_si128(correct, _mm_andnot_si128(exact[i], misplaced));
+			}
+			auto times4 = [](__m128i v) { v = _mm_add_epi8(v, v); return _mm_add_epi8(v, v); };
+			const __m128i low = _mm_or_si128(
+				_mm_or_si128(marks[0], times4(marks[1])),
+				_mm_or_si128(times4(times4(marks[2])), times4(times4(times4(marks[3])))));
+			const __m128i high = marks[4];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(results), _mm_unpacklo_epi8(low, high));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(results + 8), _mm_unpackhi_epi8(low, high));
+		}
+#endif
+	}
+
+	void write_marks(ClueCode code, std::span<char, 5> out)
+	{
+		constexpr char symbols[] = { '.', '^', '*' };
+		for (std::size_t i = 0; i < out.size(); ++i) {
+			out[i] = symbols[static_cast<std::size_t>(mark_at(code, i))];
+		}
+	}
+
+	std::string to_string(ClueCode code)
+	{
+		std::string result(5, '.');
+		write_marks(code, std::span<char, 5>(result.data(), 5));
+		return result;
+	}
+
+	CandidateSet::CandidateSet(std::span<const int> numbers) :
+		numbers_(numbers.begin(), numbers.end())
+	{
+		for (auto& column : columns_) {
+			column.reserve(numbers.size());
+		}
+		for (int number : numbers) {
+			const auto digits = to_digits(number);
+			for (std::size_t j = 0; j < digits.size(); ++j) {
+				columns_[j].push_back(digits[j]);
+			}
+		}
+	}
+
+	void CandidateSet::score(const Digits& guess, std::span<ClueCode> results) const
+	{
+		assert(results.size() >= size());
+		std::size_t i = 0;
+#if defined(CLUES_SSE2)
+		for (; i + 16 <= size(); i += 16) {
+			score_sse2(guess,
+				{ &columns_[0][i], &columns_[1][i], &columns_[2][i], &columns_[3][i], &columns_[4][i] },
+				&results[i]);
+		}
+#endif
+		for (; i < size(); ++i) {
+			results[i] = score_lane(guess,
+				{ columns_[0][i], columns_[1][i], columns_[2][i], columns_[3][i], columns_[4][i] });
+		}
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace clues
+{
+	// The five decimal digits of a number from 0 to 99999,
+	// most significant first, as "{:0>5}" would print them.
+	using Digits = std::array<std::uint8_t, 5>;
+
+	constexpr Digits to_digits(int number)
+	{
+		Digits digits{};
+		for (std::size_t i = digits.size(); i-- > 0; number /= 10) {
+			digits[i] = static_cast<std::uint8_t>(number % 10);
+		}
+		return digits;
+	}
+
+	enum class Mark : std::uint8_t
+	{
+		Absent = 0,    // '.'
+		Misplaced = 1, // '^'
+		Correct = 2    // '*'
+	};
+
+	// Two bits per position, position 0 in the lowest bits.
+	using ClueCode = std::uint16_t;
+
+	constexpr ClueCode all_correct = 0b10'10'10'10'10;
+
+	constexpr Mark mark_at(ClueCode code, std::size_t position)
+	{
+		return static_cast<Mark>((code >> (2 * position)) & 3);
+	}
+
+	// The same marks as check_which_digits_correct: exact matches first,
+	// then each other guess digit, left to right, takes one unused
+	// matching digit of the number if any is left.
+	constexpr ClueCode score(const Digits& number, const Digits& guess)
+	{
+		std::array<std::uint8_t, 10> unused{};
+		ClueCode code = 0;
+		for (std::size_t i = 0; i < guess.size(); ++i) {
+			if (guess[i] == number[i]) {
+				code |= static_cast<ClueCode>(Mark::Correct) << (2 * i);
+			}
+			else {
+				++unused[number[i]];
+			}
+		}
+		for (std::size_t i = 0; i < guess.size(); ++i) {
+			if (guess[i] != number[i] && unused[guess[i]]) {
+				--unused[guess[i]];
+				code |= static_cast<ClueCode>(Mark::Misplaced) << (2 * i);
+			}
+		}
+		return code;
+	}
+
+	// Writes the marks as '*', '^' and '.', one per position.
+	void write_marks(ClueCode code, std::span<char, 5> out);
+
+	std::string to_string(ClueCode code);
+
+	// Candidate numbers stored digit by digit in columns, so one guess
+	// can be scored against all of them in SIMD lanes.
+	class CandidateSet
+	{
+	public:
+		explicit CandidateSet(std::span<const int> numbers);
+
+		std::size_t size() const { return numbers_.size(); }
+		int number(std::size_t i) const { return numbers_[i]; }
+
+		// results[i] is score(to_digits(number(i)), guess).
+		void score(const Digits& guess, std::span<ClueCode> results) const;
+	private:
+		std::vector<int> numbers_;
+		std::array<std::vector<std::uint8_t>, 5> columns_;
+	};
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace primes
+{
+	constexpr int game_limit = 99999;
+
+	// There are 9592 primes below 100000.
+	constexpr std::size_t game_prime_count = 9592;
+
+	// Sieves odd numbers only, one bit each: bit i stands for 2i + 1
+	// and is set once that is composite. A prime below 64 marks whole
+	// words at a time, since its multiples in a word are its spacing
+	// shifted to where the first one falls. That keeps GCC to about
+	// 1.5M constexpr operations, under its default limit, but still over
+	// the 1048576 steps MSVC and Clang allow by default, so the project
+	// and the README raise their limits.
+	constexpr std::array<int, game_prime_count> make_game_primes()
+	{
+		constexpr int odd_count = (game_limit + 1) / 2;
+		constexpr int words = (odd_count + 63) / 64;
+		std::uint64_t composite[words]{};
+		for (int n = 3; n <= game_limit / n; n += 2) {
+			if (composite[n / 2 / 64] >> (n / 2 % 64) & 1) {
+				continue;
+			}
+			if (n < 64) {
+				std::uint64_t spacing = 0;
+				for (int bit = 0; bit < 64; bit += n) {
+					spacing |= std::uint64_t{ 1 } << bit;
+				}
+				const int step = n - 64 % n;
+				int first = n / 2; // where the multiples of n fall in this word
+				for (auto& word : composite) {
+					word |= spacing << first;
+					first += step;
+					first = first >= n ? first - n : first;
+				}
+				composite[n / 2 / 64] &= ~(std::uint64_t{ 1 } << (n / 2 % 64));
+				continue;
+			}
+			for (int i = n * n / 2; i < odd_count; i += n) {
+				composite[i >> 6] |= std::uint64_t{ 1 } << (i & 63);
+			}
+		}
+		composite[0] |= 1; // 1 is not prime
+		if (odd_count % 64) {
+			composite[words - 1] |= ~std::uint64_t{ 0 } << (odd_count % 64);
+		}
+
+		std::array<int, game_prime_count> result{};
+		std::size_t count = 0;
+		result[count++] = 2;
+		for (int word = 0; word < words; ++word) {
+			for (std::uint64_t primes = ~composite[word]; primes; primes &= primes - 1) {
+				result[count++] = static_cast<int>(2 * (word * 64 + std::countr_zero(primes)) + 1);
+			}
+		}
+		if (count != game_prime_count) {
+			throw "game_prime_count does not match the sieve";
+		}
+		return result;
+	}
+
+	// Built by the compiler, so picking a prime is just picking an index.
+	constexpr auto game_primes = make_game_primes();
+}
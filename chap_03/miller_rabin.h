@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace primes
+{
+	namespace detail
+	{
+		struct Wide
+		{
+			std::uint64_t high;
+			std::uint64_t low;
+		};
+
+		constexpr Wide multiply(std::uint64_t a, std::uint64_t b)
+		{
+#if defined(__SIZEOF_INT128__)
+			const auto product = static_cast<unsigned __int128>(a) * b;
+			return { static_cast<std::uint64_t>(product >> 64), static_cast<std::uint64_t>(product) };
+#else
+			const std::uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+			const std::uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+			const std::uint64_t lo_lo = a_lo * b_lo;
+			const std::uint64_t hi_lo = a_hi * b_lo;
+			const std::uint64_t lo_hi = a_lo * b_hi;
+			const std::uint64_t hi_hi = a_hi * b_hi;
+			const std::uint64_t middle = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+			return { hi_hi + (hi_lo >> 32) + (middle >> 32), (middle << 32) | (lo_lo & 0xffffffff) };
+#endif
+		}
+
+		// Arithmetic mod an odd n on values kept multiplied by R = 2^64,
+		// so reducing a product needs multiplies and a subtraction
+		// rather than a division.
+		class Montgomery
+		{
+		public:
+			constexpr explicit Montgomery(std::uint64_t n) : n_(n)
+			{
+				// Newton's method doubles the correct low bits each step;
+				// n is its own inverse mod 8 to start with.
+				inverse_ = n;
+				for (int i = 0; i < 5; ++i) {
+					inverse_ *= 2 - n * inverse_;
+				}
+				one_ = (0 - n) % n;
+				r_squared_ = one_;
+				for (int i = 0; i < 64; ++i) {
+					r_squared_ = add(r_squared_, r_squared_);
+				}
+			}
+
+			constexpr std::uint64_t one() const { return one_; }
+			constexpr std::uint64_t to_form(std::uint64_t a) const { return multiply(a % n_, r_squared_); }
+
+			constexpr std::uint64_t add(std::uint64_t a, std::uint64_t b) const
+			{
+				return a >= n_ - b ? a - (n_ - b) : a + b;
+			}
+
+			constexpr std::uint64_t multiply(std::uint64_t a, std::uint64_t b) const
+			{
+				const auto product = detail::multiply(a, b);
+				const std::uint64_t m = product.low * inverse_;
+				const std::uint64_t correction = detail::multiply(m, n_).high;
+				return product.high >= correction
+					? product.high - correction
+					: product.high - correction + n_;
+			}
+
+			constexpr std::uint64_t power(std::uint64_t base, std::uint64_t exponent) const
+			{
+				std::uint64_t result = one_;
+				for (; exponent; exponent >>= 1) {
+					if (exponent & 1) {
+						result = multiply(result, base);
+					}
+					base = multiply(base, base);
+				}
+				return result;
+			}
+		private:
+			std::uint64_t n_;
+			std::uint64_t inverse_ = 0;
+			std::uint64_t one_ = 0;
+			std::uint64_t r_squared_ = 0;
+		};
+
+		constexpr std::array<std::uint64_t, 12> small_primes{
+			2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+
+		// Residues mod 30 that share no factor with 2, 3 or 5.
+		constexpr std::array<std::uint64_t, 8> wheel{ 1, 7, 11, 13, 17, 19, 23, 29 };
+
+		constexpr std::uint64_t wheel_limit = 1 << 20;
+
+		constexpr bool is_prime_by_wheel(std::uint64_t n)
+		{
+			for (std::uint64_t base = 30; base * base <= n; base += 30) {
+				for (auto offset : wheel) {
+					const std::uint64_t divisor = base + offset;
+					if (divisor * divisor > n) {
+						return true;
+					}
+					if (n % divisor == 0) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		// Jim Sinclair's bases, which between them catch every
+		// composite below 2^64.
+		constexpr std::array<std::uint64_t, 7> witnesses{
+			2, 325, 9375, 28178, 450775, 9780504, 1795265022 };
+
+		constexpr bool is_prime_by_miller_rabin(std::uint64_t n)
+		{
+			const Montgomery mod(n);
+			std::uint64_t odd = n - 1;
+			int twos = 0;
+			while (odd % 2 == 0) {
+				odd /= 2;
+				++twos;
+			}
+			const std::uint64_t minus_one = mod.to_form(n - 1);
+			for (auto witness : witnesses) {
+				if (witness % n == 0) {
+					continue;
+				}
+				std::uint64_t x = mod.power(mod.to_form(witness), odd);
+				if (x == mod.one() || x == minus_one) {
+					continue;
+				}
+				bool composite = true;
+				for (int i = 1; i < twos && composite; ++i) {
+					x = mod.multiply(x, x);
+					composite = x != minus_one;
+				}
+				if (composite) {
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+
+	// Exact for every 64-bit n, and usable in constant expressions.
+	// Small factors are tried first; numbers below 2^20 are finished
+	// by a mod 30 wheel, the rest by deterministic Miller-Rabin.
+	constexpr bool is_prime(std::uint64_t n)
+	{
+		for (auto p : detail::small_primes) {
+			if (n % p == 0) {
+				return n == p;
+			}
+		}
+		if (n < 41 * 41) {
+			return n > 1;
+		}
+		if (n < detail::wheel_limit) {
+			return detail::is_prime_by_wheel(n);
+		}
+		return detail::is_prime_by_miller_rabin(n);
+	}
+}
@@ -0,0 +1,154 @@
+#include "prime_table.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <span>
+
+namespace primes
+{
+	namespace
+	{
+		// 32 KiB of bits per segment, to stay inside L1.
+		constexpr std::size_t segment_words = 4096;
+
+		std::uint32_t isqrt(std::uint64_t n)
+		{
+			auto root = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n)));
+			while (root * root > n) {
+				--root;
+			}
+			while ((root + 1) * (root + 1) <= n) {
+				++root;
+			}
+			return static_cast<std::uint32_t>(root);
+		}
+
+		// Bit i of words stands for the odd number 2 * (first + i) + 1.
+		void sieve_segment(std::span<std::uint64_t> words, std::uint64_t first,
+			std::span<const std::uint32_t> odd_primes)
+		{
+			std::ranges::fill(words, ~std::uint64_t{ 0 });
+			const std::uint64_t end = first + 64 * words.size();
+			if (first == 0) {
+				words[0] &= ~std::uint64_t{ 1 };
+			}
+			for (std::uint64_t p : odd_primes) {
+				std::uint64_t start = p * p / 2;
+				if (start >= end) {
+					break;
+				}
+				if (start < first) {
+					// First odd multiple of p at or after 2 * first + 1.
+					std::uint64_t multiple = (2 * first + 1 + p - 1) / p * p;
+					if (multiple % 2 == 0) {
+						multiple += p;
+					}
+					start = multiple / 2;
+				}
+				for (std::uint64_t i = start - first; i < end - first; i += p) {
+					words[i / 64] &= ~(std::uint64_t{ 1 } << (i % 64));
+				}
+			}
+		}
+
+		// Hands out segments to threads one at a time, so faster
+		// threads simply take more of them.
+		template<typename F>
+		void for_each_segment(std::size_t words, unsigned threads, F f)
+		{
+			const std::size_t segments = (words + segment_words - 1) / segment_words;
+			threads = std::clamp<unsigned>(threads, 1,
+				static_cast<unsigned>(std::max<std::size_t>(segments, 1)));
+			std::atomic<std::size_t> next{ 0 };
+			auto work = [&](unsigned thread) {
+				for (std::size_t segment; (segment = next++) < segments;) {
+					const std::size_t first = segment * segment_words;
+					f(thread, first, std::min(segment_words, words - first));
+				}
+			};
+			std::vector<std::jthread> workers;
+			for (unsigned thread = 1; thread < threads; ++thread) {
+				workers.emplace_back(work, thread);
+			}
+			work(0);
+		}
+
+		std::vector<std::uint32_t> odd_sieving_primes(std::uint64_t limit)
+		{
+			auto base = small_primes(isqrt(limit));
+			if (!base.empty()) {
+				base.erase(base.begin());
+			}
+			return base;
+		}
+
+		void clear_beyond(std::span<std::uint64_t> words, std::uint64_t first, std::uint64_t limit)
+		{
+			// Bits for odd numbers above limit start at (limit + 1) / 2.
+			const std::uint64_t last = (limit + 1) / 2;
+			for (std::uint64_t i = std::max(last, first); i < first + 64 * words.size(); ++i) {
+				words[(i - first) / 64] &= ~(std::uint64_t{ 1 } << (i % 64));
+			}
+		}
+	}
+
+	std::vector<std::uint32_t> small_primes(std::uint32_t limit)
+	{
+		std::vector<bool> composite(limit + std::size_t{ 1 });
+		std::vector<std::uint32_t> result;
+		for (std::uint64_t n = 2; n <= limit; ++n) {
+			if (composite[n]) {
+				continue;
+			}
+			result.push_back(static_cast<std::uint32_t>(n));
+			for (std::uint64_t m = n * n; m <= limit; m += n) {
+				composite[m] = true;
+			}
+		}
+		return result;
+	}
+
+	PrimeTable::PrimeTable(std::uint64_t limit, unsigned threads) :
+		limit_(limit),
+		odd_bits_(limit / 128 + 1)
+	{
+		const auto odd_primes = odd_sieving_primes(limit);
+		for_each_segment(odd_bits_.size(), threads,
+			[&](unsigned, std::size_t first_word, std::size_t words) {
+				std::span segment(odd_bits_.data() + first_word, words);
+				sieve_segment(segment, 64 * first_word, odd_primes);
+				clear_beyond(segment, 64 * first_word, limit_);
+			});
+	}
+
+	std::size_t PrimeTable::count() const
+	{
+		std::size_t total = limit_ >= 2 ? 1 : 0;
+		for (auto word : odd_bits_) {
+			total += std::popcount(word);
+		}
+		return total;
+	}
+
+	std::uint64_t count_primes(std::uint64_t limit, unsigned threads)
+	{
+		const auto odd_primes = odd_sieving_primes(limit);
+		const std::size_t words = limit / 128 + 1;
+		threads = std::max(threads, 1u);
+		std::vector<std::vector<std::uint64_t>> buffers(threads,
+			std::vector<std::uint64_t>(segment_words));
+		std::vector<std::uint64_t> counts(threads, 0);
+		for_each_segment(words, threads,
+			[&](unsigned thread, std::size_t first_word, std::size_t size) {
+				std::span segment(buffers[thread].data(), size);
+				sieve_segment(segment, 64 * first_word, odd_primes);
+				clear_beyond(segment, 64 * first_word, limit);
+				for (auto word : segment) {
+					counts[thread] += std::popcount(word);
+				}
+			});
+		return std::accumulate(counts.begin(), counts.end(), std::uint64_t{ limit >= 2 ? 1u : 0u });
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace primes
+{
+	// Primes up to sqrt-sized limits, by a plain sieve.
+	std::vector<std::uint32_t> small_primes(std::uint32_t limit);
+
+	// Every prime up to limit, found by a segmented sieve of
+	// Eratosthenes split across threads. Only odd numbers are stored,
+	// one bit each, so 2^32 takes 256 MiB.
+	class PrimeTable
+	{
+	public:
+		explicit PrimeTable(std::uint64_t limit,
+			unsigned threads = std::thread::hardware_concurrency());
+
+		std::uint64_t limit() const { return limit_; }
+
+		bool contains(std::uint64_t n) const { return n <= limit_; }
+
+		// n must be within the table.
+		bool is_prime(std::uint64_t n) const
+		{
+			if (n % 2 == 0) {
+				return n == 2;
+			}
+			return (odd_bits_[n / 128] >> (n / 2 % 64)) & 1;
+		}
+
+		std::size_t count() const;
+
+		// Calls f with each prime in increasing order.
+		template<typename F>
+		void for_each(F f) const
+		{
+			if (limit_ >= 2) {
+				f(std::uint64_t{ 2 });
+			}
+			for (std::size_t word = 0; word < odd_bits_.size(); ++word) {
+				for (auto bits = odd_bits_[word]; bits; bits &= bits - 1) {
+					f(2 * (64 * word + std::countr_zero(bits)) + 1);
+				}
+			}
+		}
+	private:
+		std::uint64_t limit_;
+		std::vector<std::uint64_t> odd_bits_;
+	};
+
+	// Counts the primes up to limit with the same segmented sieve,
+	// keeping only one cache-sized segment per thread.
+	std::uint64_t count_primes(std::uint64_t limit,
+		unsigned threads = std::thread::hardware_concurrency());
+}
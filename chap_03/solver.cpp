@@ -0,0 +1,159 @@
+#include "solver.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace solver
+{
+	namespace
+	{
+		constexpr std::size_t code_count = 1 << 10;
+
+		constexpr std::size_t max_guesses = 64;
+
+		// Lower is better.
+		double cost(Strategy strategy, const std::array<std::size_t, code_count>& groups, std::size_t total)
+		{
+			if (strategy == Strategy::Minimax) {
+				return static_cast<double>(*std::ranges::max_element(groups));
+			}
+			double entropy = 0;
+			for (auto size : groups) {
+				if (size) {
+					const double p = static_cast<double>(size) / total;
+					entropy -= p * std::log2(p);
+				}
+			}
+			return -entropy;
+		}
+	}
+
+	std::string_view to_string(Strategy strategy)
+	{
+		switch (strategy)
+		{
+		case Strategy::FirstCandidate:
+			return "first candidate";
+		case Strategy::Minimax:
+			return "minimax";
+		case Strategy::Entropy:
+			return "entropy";
+		default:
+			return "?";
+		}
+	}
+
+	double Report::mean() const
+	{
+		std::size_t total = 0;
+		for (std::size_t guesses = 0; guesses < guess_counts.size(); ++guesses) {
+			total += guesses * guess_counts[guesses];
+		}
+		return games ? static_cast<double>(total) / games : 0.0;
+	}
+
+	Solver::Solver(std::span<const int> numbers, Strategy strategy) :
+		numbers_(numbers.begin(), numbers.end()),
+		strategy_(strategy),
+		first_guess_(choose(numbers_)),
+		first_codes_(numbers_.size())
+	{
+		clues::CandidateSet(numbers_).score(clues::to_digits(first_guess_), first_codes_);
+	}
+
+	// Guesses are drawn from the candidates themselves, so each one
+	// might win outright; ties go to the earliest.
+	int Solver::choose(std::span<const int> candidates) const
+	{
+		if (strategy_ == Strategy::FirstCandidate || candidates.size() <= 2) {
+			return candidates.front();
+		}
+		const clues::CandidateSet set(candidates);
+		std::vector<clues::ClueCode> codes(candidates.size());
+		std::array<std::size_t, code_count> groups{};
+		int best = candidates.front();
+		double best_cost = std::numeric_limits<double>::infinity();
+		for (int guess : candidates) {
+			set.score(clues::to_digits(guess), codes);
+			groups.fill(0);
+			for (auto code : codes) {
+				++groups[code];
+			}
+			if (double c = cost(strategy_, groups, candidates.size()); c < best_cost) {
+				best_cost = c;
+				best = guess;
+			}
+		}
+		return best;
+	}
+
+	std::size_t Solver::play(int secret) const
+	{
+		const auto secret_digits = clues::to_digits(secret);
+		const auto first_clue = clues::score(secret_digits, clues::to_digits(first_guess_));
+		if (first_clue == clues::all_correct) {
+			return 1;
+		}
+		// The first guess is always the same, so its clues for every
+		// number are worked out once, up front.
+		std::vector<int> candidates;
+		for (std::size_t i = 0; i < numbers_.size(); ++i) {
+			if (first_codes_[i] == first_clue) {
+				candidates.push_back(numbers_[i]);
+			}
+		}
+		int guess = choose(candidates);
+		for (std::size_t guesses = 2; guesses < max_guesses; ++guesses) {
+			const auto guess_digits = clues::to_digits(guess);
+			const auto clue = clues::score(secret_digits, guess_digits);
+			if (clue == clues::all_correct) {
+				return guesses;
+			}
+			std::erase_if(candidates, [&](int candidate) {
+				return clues::score(clues::to_digits(candidate), guess_digits) != clue;
+				});
+			guess = choose(candidates);
+		}
+		return max_guesses;
+	}
+
+	Report Solver::play_all(unsigned threads) const
+	{
+		threads = std::max(threads, 1u);
+		std::vector<std::vector<std::size_t>> counts(threads, std::vector<std::size_t>(max_guesses + 1));
+		std::atomic<std::size_t> next{ 0 };
+		auto work = [&](unsigned thread) {
+			for (std::size_t game; (game = next++) < numbers_.size();) {
+				++counts[thread][play(numbers_[game])];
+			}
+		};
+
+		auto start = std::chrono::steady_clock::now();
+		{
+			std::vector<std::jthread> workers;
+			for (unsigned thread = 1; thread < threads; ++thread) {
+				workers.emplace_back(work, thread);
+			}
+			work(0);
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		Report report;
+		report.guess_counts.assign(max_guesses + 1, 0);
+		for (const auto& thread_counts : counts) {
+			std::ranges::transform(report.guess_counts, thread_counts,
+				report.guess_counts.begin(), std::plus<>{});
+		}
+		while (report.guess_counts.size() > 1 && report.guess_counts.back() == 0) {
+			report.guess_counts.pop_back();
+		}
+		report.games = numbers_.size();
+		report.seconds = elapsed.count();
+		return report;
+	}
+}
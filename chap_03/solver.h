@@ -0,0 +1,56 @@
+#pragma once
+
+#include "clues.h"
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace solver
+{
+	enum class Strategy
+	{
+		FirstCandidate, // guess any number still consistent with the clues
+		Minimax,        // guess to make the largest remaining group smallest
+		Entropy         // guess to spread the candidates most evenly
+	};
+
+	std::string_view to_string(Strategy strategy);
+
+	struct Report
+	{
+		// guess_counts[g] is how many games took g guesses.
+		std::vector<std::size_t> guess_counts;
+		std::size_t games = 0;
+		double seconds = 0;
+
+		double mean() const;
+		std::size_t worst() const { return guess_counts.size() - 1; }
+		double games_per_second() const { return games / seconds; }
+	};
+
+	// Plays the digit-clue game without a person. Every guess is a
+	// candidate prime, so the only clue that matters is the digit one,
+	// and after each clue only numbers that would give the same clue
+	// stay in play.
+	class Solver
+	{
+	public:
+		Solver(std::span<const int> numbers, Strategy strategy);
+
+		// How many guesses it takes to find secret.
+		std::size_t play(int secret) const;
+
+		// Plays every number in the list as the secret, spread over threads.
+		Report play_all(unsigned threads = std::thread::hardware_concurrency()) const;
+	private:
+		int choose(std::span<const int> candidates) const;
+
+		std::vector<int> numbers_;
+		Strategy strategy_;
+		int first_guess_;
+		std::vector<clues::ClueCode> first_codes_;
+	};
+}
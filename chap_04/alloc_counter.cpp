@@ -0,0 +1,94 @@
+#include "alloc_counter.h"
+
+#ifdef COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<std::size_t> count{ 0 };
+
+	// Calls allocate until it succeeds, as the standard operator new
+	// does: on failure the new_handler may free some memory and let it
+	// try again, and with no handler it throws.
+	template<typename F>
+	void* counted(F allocate)
+	{
+		count.fetch_add(1, std::memory_order_relaxed);
+		for (;;) {
+			if (void* p = allocate()) {
+				return p;
+			}
+			if (auto handler = std::get_new_handler()) {
+				handler();
+			}
+			else {
+				throw std::bad_alloc();
+			}
+		}
+	}
+
+	void* aligned_malloc(std::size_t size, std::align_val_t alignment)
+	{
+		const auto align = static_cast<std::size_t>(alignment);
+		size = size ? (size + align - 1) / align * align : align;
+#ifdef _MSC_VER
+		return _aligned_malloc(size, align);
+#else
+		return std::aligned_alloc(align, size);
+#endif
+	}
+
+	void aligned_free(void* p)
+	{
+#ifdef _MSC_VER
+		_aligned_free(p);
+#else
+		std::free(p);
+#endif
+	}
+}
+
+namespace bench
+{
+	std::size_t allocations()
+	{
+		return count.load(std::memory_order_relaxed);
+	}
+}
+
+// The array and nothrow forms call these by default, so between
+// them these count every allocation a new-expression makes.
+void* operator new(std::size_t size)
+{
+	return counted([size] { return std::malloc(size ? size : 1); });
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	return counted([=] { return aligned_malloc(size, alignment); });
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+	aligned_free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+	aligned_free(p);
+}
+
+#endif
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+namespace bench
+{
+#ifdef COUNT_ALLOCATIONS
+	// How many times operator new has been called so far, over-aligned
+	// forms included. Only bench builds define COUNT_ALLOCATIONS; in
+	// those, alloc_counter.cpp replaces the global operator new and
+	// delete.
+	std::size_t allocations();
+#endif
+}
@@ -1,10 +1,30 @@
+#include "alloc_counter.h"
+#include "buffered_reader.h"
+#include "civil_kernel.h"
+#include "iso_date.h"
+#include "recurrence.h"
+#include "timer_wheel.h"
+#include "zone_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <format>
 #include <iostream>
+#include <iterator>
 #include <optional>
+#include <random>
 #include <ratio>
+#include <span>
+#include <sstream>
+#include <streambuf>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 void duration_to_end_of_year() {
 	std::chrono::time_point now = std::chrono::system_clock::now();
@@ -78,6 +98,16 @@ void pay_day() {
 	std::cout << duration_cast<days>(dur) << " until pay_day \n";
 }
 
+// The next last Friday of a month, even when this month's has passed,
+// looked up in a table the compiler built.
+void next_pay_day() {
+	using namespace std::chrono;
+	time_point now = system_clock::now();
+	if (auto event = dates::next_after(dates::pay_days, now)) {
+		std::cout << duration_cast<days>(*event - now) << " until pay_day \n";
+	}
+}
+
 constexpr std::chrono::system_clock::duration
 countdown(std::chrono::system_clock::time_point start) {
 	using namespace std::chrono;
@@ -99,6 +129,22 @@ void check_properties() {
 	constexpr auto one_day_away = sys_days{ new_years_eve } - 24h;
 	constexpr auto result = countdown(one_day_away);
 	static_assert(duration_cast<days>(result) == days(1));
+
+	static_assert(dates::parse_iso_date("2026-12-31") == 2026y / December / 31);
+	static_assert(dates::parse_iso_date("2024-02-29") == 2024y / February / 29);
+	static_assert(!dates::parse_iso_date("2026-02-29"));
+	static_assert(!dates::parse_iso_date("2026-13-01"));
+	static_assert(!dates::parse_iso_date("2026-1-01"));
+	static_assert(!dates::parse_iso_date("2026/12/31"));
+
+	static_assert(dates::next_after(dates::pay_days, sys_days{ 2026y / January / 1 })
+		== sys_days{ 2026y / January / Friday[last] });
+	static_assert(dates::next_after(dates::pay_days, sys_days{ 2026y / January / Friday[last] })
+		== sys_days{ 2026y / February / Friday[last] });
+	static_assert(dates::next_after(dates::new_years_eves, one_day_away)
+		== sys_days{ new_years_eve });
+	static_assert(dates::next_after(dates::month_ends, sys_days{ 2024y / February / 28 })
+		== sys_days{ 2024y / February / 29 });
 }
 
 std::optional<std::chrono::year_month_day> read_date(std::istream& in) {
@@ -122,6 +168,31 @@ countdown_to(std::chrono::system_clock::time_point now,
 	return event - now;
 }
 
+// countdowns must be the same size as dates. The dates are split into
+// columns and turned into day counts by a batch kernel.
+void countdown_to(std::chrono::system_clock::time_point now,
+	std::span<const std::chrono::year_month_day> dates,
+	std::span<std::chrono::system_clock::duration> countdowns,
+	dates::Kernel kernel = dates::best_kernel()) {
+	using namespace std::chrono;
+	constexpr std::size_t chunk = 256;
+	std::int32_t years[chunk], months[chunk], month_days[chunk], day_counts[chunk];
+	for (std::size_t from = 0; from < dates.size(); from += chunk) {
+		const std::size_t count = std::min(chunk, dates.size() - from);
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto& date = dates[from + i];
+			years[i] = static_cast<int>(date.year());
+			months[i] = static_cast<int>(static_cast<unsigned>(date.month()));
+			month_days[i] = static_cast<int>(static_cast<unsigned>(date.day()));
+		}
+		dates::days_from_civil(kernel, std::span(years, count), std::span(months, count),
+			std::span(month_days, count), std::span(day_counts, count));
+		for (std::size_t i = 0; i < count; ++i) {
+			countdowns[from + i] = sys_days{ days{ day_counts[i] } } - now;
+		}
+	}
+}
+
 std::chrono::system_clock::duration
 countdown_in_local_time(std::chrono::system_clock::time_point now,
 	std::chrono::year_month_day date) {
@@ -131,8 +202,490 @@ countdown_in_local_time(std::chrono::system_clock::time_point now,
 	return sys_event - now;
 }
 
-int main() {
+// The zone and its offsets come from the cache instead of the tzdb.
+std::chrono::system_clock::duration
+countdown_in_local_time(std::chrono::system_clock::time_point now,
+	std::chrono::year_month_day date,
+	const dates::ZoneCache& zone) {
+	using namespace std::chrono;
+	return zone.to_sys(local_days{ date }) - now;
+}
+
+// countdowns must be the same size as dates.
+void countdown_in_local_time(std::chrono::system_clock::time_point now,
+	std::span<const std::chrono::year_month_day> dates,
+	std::span<std::chrono::system_clock::duration> countdowns,
+	const dates::ZoneCache& zone) {
+	using namespace std::chrono;
+	constexpr std::size_t chunk = 256;
+	local_days local[chunk];
+	sys_seconds sys[chunk];
+	for (std::size_t from = 0; from < dates.size(); from += chunk) {
+		const std::size_t count = std::min(chunk, dates.size() - from);
+		for (std::size_t i = 0; i < count; ++i) {
+			local[i] = local_days{ dates[from + i] };
+		}
+		zone.to_sys(std::span(local, count), std::span(sys, count));
+		for (std::size_t i = 0; i < count; ++i) {
+			countdowns[from + i] = sys[i] - now;
+		}
+	}
+}
+
+void write_countdown(std::string& out,
+	std::chrono::system_clock::duration dur,
+	std::chrono::year_month_day date) {
+	using namespace std::chrono;
+	// "{}d" is how std::format writes days, and "{:%F}" is the
+	// zero-padded date; integers skip the chrono formatters.
+	// Formatting into a local array avoids a push_back per character.
+	char line[64];
+	auto result = std::format_to_n(line, sizeof line, "{}d until {:04}-{:02}-{:02}\n",
+		duration_cast<days>(dur).count(),
+		static_cast<int>(date.year()),
+		static_cast<unsigned>(date.month()),
+		static_cast<unsigned>(date.day()));
+	out.append(line, result.out);
+}
+
+// Reads whitespace separated YYYY-MM-DD records until the input runs
+// out and writes a line for each, as main does for one date.
+// The text goes through one reused buffer. Returns the record count.
+std::size_t countdown_records(std::istream& in, std::ostream& out,
+	std::chrono::system_clock::time_point now) {
+	constexpr std::size_t flush_at = 1 << 16;
+	input::BufferedReader reader(in);
+	std::string buffer;
+	buffer.reserve(flush_at + 64);
+	std::size_t records = 0;
+	while (auto record = reader.next_token()) {
+		++records;
+		if (auto date = dates::parse_iso_date(*record)) {
+			write_countdown(buffer, countdown_to(now, *date), *date);
+		}
+		else {
+			buffer += "Invalid format. Expected %Y-%m-%d\n";
+		}
+		if (buffer.size() >= flush_at) {
+			out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			buffer.clear();
+		}
+	}
+	out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	return records;
+}
+
+template <typename F>
+double seconds_taken(F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+
+class CountingBuffer : public std::streambuf {
+public:
+	std::size_t bytes = 0;
+protected:
+	int_type overflow(int_type ch) override {
+		++bytes;
+		return traits_type::not_eof(ch);
+	}
+	std::streamsize xsputn(const char*, std::streamsize count) override {
+		bytes += static_cast<std::size_t>(count);
+		return count;
+	}
+};
+
+// Random dates from 1970 to 2100, one per line.
+std::string make_date_records(std::size_t count) {
+	using namespace std::chrono;
+	std::mt19937 engine(2026);
+	std::uniform_int_distribution<int> day_number(0, 47846);
+	std::string text;
+	text.reserve(count * 11);
+	for (std::size_t i = 0; i < count; ++i) {
+		const year_month_day date{ sys_days{ days{ day_number(engine) } } };
+		std::format_to(std::back_inserter(text), "{:04}-{:02}-{:02}\n",
+			static_cast<int>(date.year()),
+			static_cast<unsigned>(date.month()),
+			static_cast<unsigned>(date.day()));
+	}
+	return text;
+}
+
+void benchmark_countdowns(std::ostream& os) {
 	using namespace std::chrono;
+	constexpr std::size_t records = 1'000'000;
+	const std::string text = make_date_records(records);
+	const auto now = system_clock::now();
+
+	// One record at a time, the way main reads its date.
+	auto one_at_a_time = [&](std::istream& in, std::ostream& out) {
+		std::size_t count = 0;
+		std::string str;
+		while (in >> str) {
+			++count;
+			std::istringstream record(str);
+			if (auto date = read_date(record)) {
+				out << std::format("{} until {:%F}\n",
+					duration_cast<days>(countdown_to(now, *date)), *date);
+			}
+		}
+		return count;
+	};
+
+	{
+		std::istringstream sample(text.substr(0, 11 * 1000));
+		std::ostringstream expected;
+		one_at_a_time(sample, expected);
+		std::istringstream same_sample(text.substr(0, 11 * 1000));
+		std::ostringstream bulk;
+		countdown_records(same_sample, bulk, now);
+		assert(bulk.str() == expected.str());
+	}
+
+	os << std::format("{:>28} {:>14}\n", "date records", "records/sec");
+	auto report = [&](std::string_view name, auto countdowns) {
+		std::istringstream in(text);
+		CountingBuffer counter;
+		std::ostream out(&counter);
+		std::size_t count = 0;
+		double taken = seconds_taken([&] { count = countdowns(in, out); });
+		assert(count == records);
+		os << std::format("{:>28} {:>14.0f}\n", name, count / taken);
+	};
+	report("read_date", one_at_a_time);
+	report("countdown_records", [&](std::istream& in, std::ostream& out) {
+		return countdown_records(in, out, now);
+		});
+}
+
+void benchmark_civil_kernels(std::ostream& os) {
+	using namespace std::chrono;
+	dates::check_civil_kernels();
+
+	constexpr std::size_t count = 1 << 20;
+	std::mt19937 engine(2026);
+	std::uniform_int_distribution<int> day_number(-200'000, 200'000);
+	std::vector<std::int32_t> day_counts(count), years(count), months(count), month_days(count);
+	std::vector<year_month_day> ymds(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		day_counts[i] = day_number(engine);
+		ymds[i] = year_month_day{ sys_days{ days{ day_counts[i] } } };
+		years[i] = static_cast<int>(ymds[i].year());
+		months[i] = static_cast<int>(static_cast<unsigned>(ymds[i].month()));
+		month_days[i] = static_cast<int>(static_cast<unsigned>(ymds[i].day()));
+	}
+
+	os << std::format("{:>28} {:>14} {:>14}\n", "civil dates", "to days/ns", "from days/ns");
+	auto report = [&os](std::string_view name, auto to_days, auto from_days) {
+		const double to = seconds_taken(to_days);
+		const double from = seconds_taken(from_days);
+		os << std::format("{:>28} {:>14.3f} {:>14.3f}\n", name, count / to * 1e-9, count / from * 1e-9);
+	};
+	std::vector<std::int32_t> got_counts(count);
+	std::vector<year_month_day> got_ymds(count);
+	report("std::chrono",
+		[&] {
+			for (std::size_t i = 0; i < count; ++i) {
+				got_counts[i] = sys_days{ ymds[i] }.time_since_epoch().count();
+			}
+		},
+		[&] {
+			for (std::size_t i = 0; i < count; ++i) {
+				got_ymds[i] = year_month_day{ sys_days{ days{ day_counts[i] } } };
+			}
+		});
+	assert(got_counts == day_counts && got_ymds == ymds);
+	for (auto kernel : { dates::Kernel::Scalar, dates::Kernel::AVX2 }) {
+		if (!dates::is_supported(kernel)) {
+			continue;
+		}
+		std::vector<std::int32_t> got_years(count), got_months(count), got_days(count);
+		report(dates::to_string(kernel),
+			[&] { dates::days_from_civil(kernel, years, months, month_days, got_counts); },
+			[&] { dates::civil_from_days(kernel, day_counts, got_years, got_months, got_days); });
+		assert(got_counts == day_counts);
+		assert(got_years == years && got_months == months && got_days == month_days);
+	}
+
+	const auto now = system_clock::now();
+	std::vector<system_clock::duration> expected(count), countdowns(count);
+	os << std::format("{:>28} {:>14}\n", "countdown_to", "dates/ns");
+	double taken = seconds_taken([&] {
+		for (std::size_t i = 0; i < count; ++i) {
+			expected[i] = countdown_to(now, ymds[i]);
+		}
+		});
+	os << std::format("{:>28} {:>14.3f}\n", "one date", count / taken * 1e-9);
+	taken = seconds_taken([&] { countdown_to(now, ymds, countdowns); });
+	os << std::format("{:>28} {:>14.3f}\n", "span of dates", count / taken * 1e-9);
+	assert(countdowns == expected);
+}
+
+void benchmark_calendar(std::ostream& os) {
+	using namespace std::chrono;
+	constexpr std::size_t queries = 1'000'000;
+	const std::array rules{
+		dates::Rule::last_weekday(Friday),
+		dates::Rule::nth_weekday(Monday[1]),
+		dates::Rule::last_day(),
+		dates::Rule::fixed(December / 31) };
+	const dates::CalendarIndex index(rules, 1900y, 2299y);
+
+	std::mt19937 engine(2026);
+	std::uniform_int_distribution<long long> second(
+		sys_seconds{ sys_days{ 1900y / January / 1 } }.time_since_epoch().count(),
+		sys_seconds{ sys_days{ 2199y / December / 1 } }.time_since_epoch().count());
+	std::vector<system_clock::time_point> times(queries);
+	for (auto& t : times) {
+		t = sys_seconds{ seconds{ second(engine) } };
+	}
+
+	// Without the index: this month's and next month's occurrence of
+	// every rule, keeping the earliest after t.
+	auto next_by_rules = [&rules](system_clock::time_point t) {
+		const year_month ym{ year_month_day{ floor<days>(t) }.year(), year_month_day{ floor<days>(t) }.month() };
+		std::optional<sys_days> best;
+		for (const auto& rule : rules) {
+			for (auto when : { ym, ym + months{ 1 } }) {
+				if (auto day = rule.occurrence(when); day && *day > t && (!best || *day < *best)) {
+					best = day;
+				}
+			}
+		}
+		return best;
+	};
+
+	std::vector<sys_days> expected(queries), found(queries);
+	os << std::format("{:>28} {:>14}\n", "next occurrence", "ns/query");
+	auto report = [&](std::string_view name, auto next, std::vector<sys_days>& out) {
+		double taken = seconds_taken([&] {
+			for (std::size_t i = 0; i < queries; ++i) {
+				out[i] = *next(times[i]);
+			}
+			});
+		os << std::format("{:>28} {:>14.1f}\n", name, taken * 1e9 / queries);
+	};
+	report("rules", next_by_rules, expected);
+	report("CalendarIndex", [&index](system_clock::time_point t) {
+		return std::optional{ index.next_after(t)->day };
+		}, found);
+	assert(found == expected);
+}
+
+void benchmark_local_time(std::ostream& os) {
+	using namespace std::chrono;
+	constexpr std::size_t count = 100'000;
+	std::mt19937 engine(2026);
+	std::uniform_int_distribution<int> day_number(
+		sys_days{ 2020y / January / 1 }.time_since_epoch().count(),
+		sys_days{ 2030y / December / 31 }.time_since_epoch().count());
+	std::vector<year_month_day> dates(count);
+	for (auto& date : dates) {
+		date = year_month_day{ sys_days{ days{ day_number(engine) } } };
+	}
+	const auto now = system_clock::now();
+	const dates::ZoneCache zone(2020y, 2030y);
+
+	std::vector<system_clock::duration> expected(count);
+	std::vector<system_clock::duration> countdowns(count);
+	os << std::format("{:>28} {:>14}\n", "local countdowns", "ns/date");
+	auto report = [&](std::string_view name, auto countdown_all) {
+		double taken = seconds_taken([&] { countdown_all(countdowns); });
+		os << std::format("{:>28} {:>14.1f}\n", name, taken * 1e9 / count);
+	};
+	report("zoned_time", [&](auto& out) {
+		for (std::size_t i = 0; i < count; ++i) {
+			out[i] = countdown_in_local_time(now, dates[i]);
+		}
+		});
+	expected = countdowns;
+	report("ZoneCache", [&](auto& out) {
+		for (std::size_t i = 0; i < count; ++i) {
+			out[i] = countdown_in_local_time(now, dates[i], zone);
+		}
+		});
+	assert(countdowns == expected);
+	report("ZoneCache batch", [&](auto& out) {
+		countdown_in_local_time(now, dates, out, zone);
+		});
+	assert(countdowns == expected);
+}
+
+// Prints the countdown every interval. The deadlines are fixed from
+// the start, so time spent printing does not add up as it does with
+// sleep_for.
+void tick_countdown(int ticks, std::chrono::steady_clock::duration interval) {
+	using namespace std::chrono;
+	timers::TimerWheel wheel;
+	const auto start = steady_clock::now();
+	for (int i = 1; i <= ticks; ++i) {
+		wheel.schedule(start + i * interval, [] {
+			auto dur = countdown(system_clock::now());
+			std::cout << duration_cast<seconds>(dur) << " until event\n";
+			});
+	}
+	wheel.run();
+}
+
+// Schedules events spread over two seconds, cancels every tenth,
+// and runs the rest.
+void benchmark_scheduler(std::ostream& os, std::size_t events) {
+	using namespace std::chrono;
+	std::mt19937 engine(2026);
+	std::uniform_int_distribution<long long> offset_us(0, 2'000'000);
+	timers::TimerWheel wheel;
+	const auto start = steady_clock::now() + milliseconds{ 100 };
+	std::vector<steady_clock::time_point> deadlines(events);
+	for (auto& deadline : deadlines) {
+		deadline = start + microseconds{ offset_us(engine) };
+	}
+	std::vector<timers::Timer> scheduled(events);
+	std::size_t fired = 0;
+	const double insert = seconds_taken([&] {
+		for (std::size_t i = 0; i < events; ++i) {
+			scheduled[i] = wheel.schedule(deadlines[i], [&fired] { ++fired; });
+		}
+		});
+	std::size_t cancelled = 0;
+	const double cancel = seconds_taken([&] {
+		for (std::size_t i = 0; i < events; i += 10) {
+			cancelled += wheel.cancel(scheduled[i]);
+		}
+		});
+	wheel.run();
+	assert(fired + cancelled == events);
+
+	const auto& late = wheel.lateness();
+	os << std::format("{} events, {} cancelled, {} fired\n", events, cancelled, fired);
+	os << std::format("{:>28} {:>14.1f}\n", "ns/schedule", insert * 1e9 / events);
+	os << std::format("{:>28} {:>14.1f}\n", "ns/cancel", cancelled ? cancel * 1e9 / cancelled : 0.0);
+	os << std::format("{:>28} {:>14.1f}\n", "drift (us)", late.drift() * 1e6);
+	os << std::format("{:>28} {:>14.1f}\n", "jitter (us)", late.jitter() * 1e6);
+	os << std::format("{:>28} {:>14.1f}\n", "worst (us)", late.worst_seconds * 1e6);
+}
+
+#ifdef COUNT_ALLOCATIONS
+// Keeps the optimiser from discarding a result.
+template <typename T>
+void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile char sink;
+	sink = *reinterpret_cast<const volatile char*>(&value);
+#endif
+}
+
+// Times each chrono path used above, one call per op, and counts the
+// heap allocations each call makes.
+void benchmark_chrono(std::ostream& os) {
+	using namespace std::chrono;
+	constexpr std::size_t ops = 200'000;
+	constexpr std::size_t inputs = 1024;
+	std::mt19937 engine(2026);
+	std::uniform_int_distribution<int> day_number(
+		sys_days{ 2020y / January / 1 }.time_since_epoch().count(),
+		sys_days{ 2030y / December / 31 }.time_since_epoch().count());
+	std::vector<year_month_day> ymds(inputs);
+	std::vector<std::string> texts(inputs);
+	for (std::size_t i = 0; i < inputs; ++i) {
+		ymds[i] = year_month_day{ sys_days{ days{ day_number(engine) } } };
+		texts[i] = std::format("{:%F}", ymds[i]);
+	}
+	const auto now = system_clock::now();
+	const dates::ZoneCache zone(2020y, 2030y);
+	std::string line;
+
+	os << std::format("{:>36} {:>12} {:>12}\n", "path", "ns/op", "allocs/op");
+	auto measure = [&](std::string_view name, auto op) {
+		for (std::size_t i = 0; i < inputs; ++i) {
+			op(i);
+		}
+		const std::size_t allocations = bench::allocations();
+		double taken = seconds_taken([&] {
+			for (std::size_t i = 0; i < ops; ++i) {
+				op(i % inputs);
+			}
+			});
+		const std::size_t made = bench::allocations() - allocations;
+		os << std::format("{:>36} {:>12.1f} {:>12.2f}\n", name,
+			taken * 1e9 / ops, static_cast<double>(made) / ops);
+	};
+
+	measure("parse (read_date)", [&](std::size_t i) {
+		std::istringstream in(texts[i]);
+		keep(read_date(in));
+		});
+	measure("dates::parse_iso_date", [&](std::size_t i) {
+		keep(dates::parse_iso_date(texts[i]));
+		});
+	measure("format {:%F}", [&](std::size_t i) {
+		keep(std::format("{:%F}", ymds[i]));
+		});
+	measure("format countdown line", [&](std::size_t i) {
+		keep(std::format("{} until {:%F}\n", duration_cast<days>(countdown_to(now, ymds[i])), ymds[i]));
+		});
+	measure("write_countdown", [&](std::size_t i) {
+		line.clear();
+		write_countdown(line, countdown_to(now, ymds[i]), ymds[i]);
+		keep(line.size());
+		});
+	measure("countdown_to", [&](std::size_t i) {
+		keep(countdown_to(now, ymds[i]));
+		});
+	measure("countdown", [&](std::size_t i) {
+		keep(countdown(now + days{ static_cast<int>(i) }));
+		});
+	measure("duration_cast<days>", [&](std::size_t i) {
+		keep(duration_cast<days>(now.time_since_epoch() + hours{ i }));
+		});
+	measure("centuries to seconds to days", [&](std::size_t i) {
+		using centuries = duration<long long, std::ratio_multiply<years::period, std::hecto>>;
+		const seconds sec = centuries(static_cast<long long>(i));
+		keep(duration_cast<days>(sec));
+		});
+	measure("year_month_day{ sys_days }", [&](std::size_t i) {
+		keep(year_month_day{ sys_days{ ymds[i] } + days{ 1 } });
+		});
+	measure("zoned_time (local countdown)", [&](std::size_t i) {
+		keep(countdown_in_local_time(now, ymds[i]));
+		});
+	measure("ZoneCache (local countdown)", [&](std::size_t i) {
+		keep(countdown_in_local_time(now, ymds[i], zone));
+		});
+	measure("pay_days next_after", [&](std::size_t i) {
+		keep(dates::next_after(dates::pay_days, sys_days{ ymds[i] }));
+		});
+}
+#endif
+
+int main(int argc, char* argv[]) {
+	using namespace std::chrono;
+	if (argc > 1 && std::string_view(argv[1]) == "--bench") {
+		benchmark_countdowns(std::cout);
+		benchmark_local_time(std::cout);
+		benchmark_civil_kernels(std::cout);
+		benchmark_calendar(std::cout);
+		return 0;
+	}
+#ifdef COUNT_ALLOCATIONS
+	if (argc > 1 && std::string_view(argv[1]) == "--micro") {
+		benchmark_chrono(std::cout);
+		return 0;
+	}
+#endif
+	if (argc > 1 && std::string_view(argv[1]) == "--batch") {
+		std::ios::sync_with_stdio(false);
+		countdown_records(std::cin, std::cout, system_clock::now());
+		return 0;
+	}
+	if (argc > 2 && std::string_view(argv[1]) == "--schedule") {
+		benchmark_scheduler(std::cout, std::stoul(argv[2]));
+		return 0;
+	}
 	std::cout << "Enter a date\n";
 	std::string str;
 	std::cin >> str;
@@ -146,10 +699,6 @@ int main() {
 			event_date.value());
 	}
 	//check_properties();
-	//for (int i = 0; i < 5; ++i) {
-	//	std::this_thread::sleep_for(5000ms);
-	//	auto dur = countdown(system_clock::now());
-	//	std::cout << duration_cast<seconds>(dur) << " until event\n";
-	//}
+	//tick_countdown(5, 5000ms);
 }
 
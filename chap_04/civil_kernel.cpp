@@ -0,0 +1,290 @@
+#include "civil_kernel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DATES_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(DATES_X86) && (defined(__GNUC__) || defined(__clang__))
+#define DATES_TARGET(isa) __attribute__((target(isa)))
+#else
+#define DATES_TARGET(isa)
+#endif
+
+namespace dates
+{
+	namespace
+	{
+		// Counting years from 400 * 82 before year 0 keeps every year in
+		// std::chrono's range positive, so the arithmetic can be unsigned
+		// and floor division is plain division. 400 years is a whole
+		// number of days, 146097, so the shift is exact.
+		constexpr std::uint32_t shift_years = 400 * 82;
+
+		// Days from 0000-03-01 to 1970-01-01, plus the shift. Starting the
+		// year in March puts the leap day last.
+		constexpr std::uint32_t shift_days = 719468 + 146097 * 82;
+
+		std::int32_t from_civil_scalar(std::int32_t y, std::int32_t m, std::int32_t d)
+		{
+			const std::uint32_t before_march = m <= 2;
+			const std::uint32_t year = static_cast<std::uint32_t>(y) + shift_years - before_march;
+			const std::uint32_t month = static_cast<std::uint32_t>(m) + 9 - 12 * (1 - before_march);
+			const std::uint32_t day_of_year = (153 * month + 2) / 5 + static_cast<std::uint32_t>(d) - 1;
+			const std::uint32_t day = 365 * year + year / 4 - year / 100 + year / 400 + day_of_year;
+			return static_cast<std::int32_t>(day - shift_days);
+		}
+
+		void from_civil_scalar(const std::int32_t* years, const std::int32_t* months, const std::int32_t* days,
+			std::int32_t* day_counts, std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				day_counts[i] = from_civil_scalar(years[i], months[i], days[i]);
+			}
+		}
+
+		// Neri and Schneider's inverse: each division either has a
+		// constant divisor or is by a power of two after a widening
+		// multiply, and the year starts in March until the last step.
+		void to_civil_scalar(const std::int32_t* day_counts,
+			std::int32_t* years, std::int32_t* months, std::int32_t* days, std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i) {
+				const std::uint32_t day = static_cast<std::uint32_t>(day_counts[i]) + shift_days;
+				const std::uint32_t quarter_days = 4 * day + 3;
+				const std::uint32_t century = quarter_days / 146097;
+				const std::uint32_t day_of_century = quarter_days % 146097 / 4;
+				const std::uint64_t product = std::uint64_t{ 2939745 } * (4 * day_of_century + 3);
+				const std::uint32_t year_of_century = static_cast<std::uint32_t>(product >> 32);
+				const std::uint32_t day_of_year = static_cast<std::uint32_t>(product) / 2939745 / 4;
+				const std::uint32_t month_and_day = 2141 * day_of_year + 197913;
+				const std::uint32_t before_march = day_of_year >= 306;
+				days[i] = static_cast<std::int32_t>((month_and_day & 0xffff) / 2141 + 1);
+				months[i] = static_cast<std::int32_t>((month_and_day >> 16) - 12 * before_march);
+				years[i] = static_cast<std::int32_t>(100 * century + year_of_century + before_march)
+					- static_cast<std::int32_t>(shift_years);
+			}
+		}
+
+#if defined(DATES_X86)
+		// The scalar sums with the divisions done as multiplies and shifts.
+		// A year divided by 100 is the year divided by 4 and then by 25;
+		// both multipliers are exact for every shifted year and month.
+		DATES_TARGET("avx2")
+		void from_civil_avx2(const std::int32_t* years, const std::int32_t* months, const std::int32_t* days,
+			std::int32_t* day_counts, std::size_t n)
+		{
+			const __m256i one = _mm256_set1_epi32(1);
+			std::size_t i = 0;
+			for (; i + 8 <= n; i += 8) {
+				const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(years + i));
+				const __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(months + i));
+				const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(days + i));
+				// All ones in lanes for January and February.
+				const __m256i before_march = _mm256_cmpgt_epi32(_mm256_set1_epi32(3), m);
+				const __m256i year = _mm256_add_epi32(_mm256_add_epi32(y, _mm256_set1_epi32(shift_years)), before_march);
+				const __m256i month = _mm256_sub_epi32(_mm256_add_epi32(m, _mm256_set1_epi32(9)),
+					_mm256_andnot_si256(before_march, _mm256_set1_epi32(12)));
+				const __m256i by_4 = _mm256_srli_epi32(year, 2);
+				const __m256i by_100 = _mm256_srli_epi32(_mm256_mullo_epi32(by_4, _mm256_set1_epi32(5243)), 17);
+				const __m256i by_400 = _mm256_srli_epi32(by_100, 2);
+				const __m256i month_days = _mm256_srli_epi32(_mm256_mullo_epi32(
+					_mm256_add_epi32(_mm256_mullo_epi32(month, _mm256_set1_epi32(153)), _mm256_set1_epi32(2)),
+					_mm256_set1_epi32(13108)), 16);
+				__m256i day = _mm256_mullo_epi32(year, _mm256_set1_epi32(365));
+				day = _mm256_add_epi32(day, _mm256_sub_epi32(by_4, by_100));
+				day = _mm256_add_epi32(day, _mm256_add_epi32(by_400, month_days));
+				day = _mm256_add_epi32(day, _mm256_sub_epi32(d, one));
+				day = _mm256_sub_epi32(day, _mm256_set1_epi32(shift_days));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(day_counts + i), day);
+			}
+			from_civil_scalar(years + i, months + i, days + i, day_counts + i, n - i);
+		}
+
+		// floor(x / divisor) for a whole x. (x + 1/2) / divisor is at least
+		// 1 / (2 * divisor) away from any integer, far more than the
+		// rounding error of multiplying by the reciprocal.
+		DATES_TARGET("avx2")
+		inline __m256d floor_divide(__m256d x, double divisor)
+		{
+			return _mm256_floor_pd(_mm256_mul_pd(_mm256_add_pd(x, _mm256_set1_pd(0.5)),
+				_mm256_set1_pd(1 / divisor)));
+		}
+
+		// The scalar steps in doubles, four lanes at a time, since AVX2 has
+		// no widening 32-bit multiply with a high half for every lane.
+		// Every value is a whole number inside a double's 53 bits, and
+		// dividing by a power of two is exact.
+		DATES_TARGET("avx2")
+		void to_civil_avx2(const std::int32_t* day_counts,
+			std::int32_t* years, std::int32_t* months, std::int32_t* days, std::size_t n)
+		{
+			const __m256d one = _mm256_set1_pd(1);
+			const __m256d three = _mm256_set1_pd(3);
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				const __m256d day = _mm256_add_pd(
+					_mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(day_counts + i))),
+					_mm256_set1_pd(shift_days));
+				const __m256d quarter_days = _mm256_add_pd(_mm256_mul_pd(day, _mm256_set1_pd(4)), three);
+				const __m256d century = floor_divide(quarter_days, 146097);
+				const __m256d day_of_century = _mm256_floor_pd(_mm256_mul_pd(
+					_mm256_sub_pd(quarter_days, _mm256_mul_pd(century, _mm256_set1_pd(146097))),
+					_mm256_set1_pd(0.25)));
+				const __m256d product = _mm256_mul_pd(_mm256_set1_pd(2939745),
+					_mm256_add_pd(_mm256_mul_pd(day_of_century, _mm256_set1_pd(4)), three));
+				const __m256d year_of_century = _mm256_floor_pd(
+					_mm256_mul_pd(product, _mm256_set1_pd(0x1p-32)));
+				const __m256d day_of_year = floor_divide(
+					_mm256_sub_pd(product, _mm256_mul_pd(year_of_century, _mm256_set1_pd(0x1p32))),
+					2939745.0 * 4);
+				const __m256d month_and_day = _mm256_add_pd(
+					_mm256_mul_pd(day_of_year, _mm256_set1_pd(2141)), _mm256_set1_pd(197913));
+				const __m256d month = _mm256_floor_pd(_mm256_mul_pd(month_and_day, _mm256_set1_pd(0x1p-16)));
+				const __m256d before_march = _mm256_and_pd(
+					_mm256_cmp_pd(day_of_year, _mm256_set1_pd(306), _CMP_GE_OQ), one);
+				const __m256d d = _mm256_add_pd(floor_divide(
+					_mm256_sub_pd(month_and_day, _mm256_mul_pd(month, _mm256_set1_pd(0x1p16))), 2141), one);
+				const __m256d m = _mm256_sub_pd(month, _mm256_mul_pd(before_march, _mm256_set1_pd(12)));
+				__m256d y = _mm256_add_pd(_mm256_mul_pd(century, _mm256_set1_pd(100)), year_of_century);
+				y = _mm256_sub_pd(_mm256_add_pd(y, before_march), _mm256_set1_pd(shift_years));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(years + i), _mm256_cvtpd_epi32(y));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(months + i), _mm256_cvtpd_epi32(m));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(days + i), _mm256_cvtpd_epi32(d));
+			}
+			to_civil_scalar(day_counts + i, years + i, months + i, days + i, n - i);
+		}
+
+		bool cpu_has_avx2()
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7) {
+				return false;
+			}
+			__cpuid(info, 1);
+			const bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+			__cpuidex(info, 7, 0);
+			return os_saves_ymm && (info[1] & (1 << 5));
+#else
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+#endif
+	}
+
+	std::string_view to_string(Kernel kernel)
+	{
+		switch (kernel)
+		{
+		case Kernel::Scalar:
+			return "scalar";
+		case Kernel::AVX2:
+			return "avx2";
+		default:
+			return "?";
+		}
+	}
+
+	bool is_supported(Kernel kernel)
+	{
+#if defined(DATES_X86)
+		static const bool avx2 = cpu_has_avx2();
+		if (kernel == Kernel::AVX2) {
+			return avx2;
+		}
+#endif
+		return kernel == Kernel::Scalar;
+	}
+
+	Kernel best_kernel()
+	{
+		return is_supported(Kernel::AVX2) ? Kernel::AVX2 : Kernel::Scalar;
+	}
+
+	void days_from_civil(Kernel kernel,
+		std::span<const std::int32_t> years,
+		std::span<const std::int32_t> months,
+		std::span<const std::int32_t> days,
+		std::span<std::int32_t> day_counts)
+	{
+		if (months.size() != years.size() || days.size() != years.size() || day_counts.size() != years.size()) {
+			throw std::invalid_argument("days_from_civil needs spans of one size");
+		}
+		assert(is_supported(kernel));
+		switch (kernel)
+		{
+#if defined(DATES_X86)
+		case Kernel::AVX2:
+			from_civil_avx2(years.data(), months.data(), days.data(), day_counts.data(), years.size());
+			return;
+#endif
+		default:
+			from_civil_scalar(years.data(), months.data(), days.data(), day_counts.data(), years.size());
+		}
+	}
+
+	void civil_from_days(Kernel kernel,
+		std::span<const std::int32_t> day_counts,
+		std::span<std::int32_t> years,
+		std::span<std::int32_t> months,
+		std::span<std::int32_t> days)
+	{
+		if (years.size() != day_counts.size() || months.size() != day_counts.size() || days.size() != day_counts.size()) {
+			throw std::invalid_argument("civil_from_days needs spans of one size");
+		}
+		assert(is_supported(kernel));
+		switch (kernel)
+		{
+#if defined(DATES_X86)
+		case Kernel::AVX2:
+			to_civil_avx2(day_counts.data(), years.data(), months.data(), days.data(), day_counts.size());
+			return;
+#endif
+		default:
+			to_civil_scalar(day_counts.data(), years.data(), months.data(), days.data(), day_counts.size());
+		}
+	}
+
+	void check_civil_kernels()
+	{
+		using namespace std::chrono;
+		const int first = sys_days{ year::min() / January / 1 }.time_since_epoch().count();
+		const int last = sys_days{ year::max() / December / 31 }.time_since_epoch().count();
+		constexpr std::size_t block = 1 << 16;
+		std::vector<std::int32_t> day_counts(block), years(block), months(block), days(block);
+		std::vector<std::int32_t> got_counts(block), got_years(block), got_months(block), got_days(block);
+		for (int from = first; from <= last; from += static_cast<int>(block)) {
+			const std::size_t n = std::min<std::size_t>(block, static_cast<std::size_t>(last - from) + 1);
+			for (std::size_t i = 0; i < n; ++i) {
+				day_counts[i] = from + static_cast<int>(i);
+				const year_month_day date{ sys_days{ std::chrono::days{ day_counts[i] } } };
+				years[i] = static_cast<int>(date.year());
+				months[i] = static_cast<int>(static_cast<unsigned>(date.month()));
+				days[i] = static_cast<int>(static_cast<unsigned>(date.day()));
+			}
+			for (auto kernel : { Kernel::Scalar, Kernel::AVX2 }) {
+				if (!is_supported(kernel)) {
+					continue;
+				}
+				auto all = [n](auto& values) { return std::span(values).first(n); };
+				days_from_civil(kernel, all(years), all(months), all(days), all(got_counts));
+				assert(std::ranges::equal(all(got_counts), all(day_counts)));
+				civil_from_days(kernel, all(day_counts), all(got_years), all(got_months), all(got_days));
+				assert(std::ranges::equal(all(got_years), all(years)));
+				assert(std::ranges::equal(all(got_months), all(months)));
+				assert(std::ranges::equal(all(got_days), all(days)));
+			}
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace dates
+{
+	enum class Kernel
+	{
+		Scalar,
+		AVX2
+	};
+
+	std::string_view to_string(Kernel kernel);
+
+	bool is_supported(Kernel kernel);
+
+	// The widest kernel this CPU can run.
+	Kernel best_kernel();
+
+	// Days since 1970-01-01 for each valid proleptic Gregorian date in
+	// std::chrono's range of years, as sys_days(year / month / day) gives.
+	// All spans must be the same size.
+	void days_from_civil(Kernel kernel,
+		std::span<const std::int32_t> years,
+		std::span<const std::int32_t> months,
+		std::span<const std::int32_t> days,
+		std::span<std::int32_t> day_counts);
+
+	// The inverse, as year_month_day(sys_days(day_count)) gives.
+	void civil_from_days(Kernel kernel,
+		std::span<const std::int32_t> day_counts,
+		std::span<std::int32_t> years,
+		std::span<std::int32_t> months,
+		std::span<std::int32_t> days);
+
+	// Compares every supported kernel with std::chrono on every day
+	// from year -32767 to year 32767.
+	void check_civil_kernels();
+}
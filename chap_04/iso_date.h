@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace dates
+{
+	namespace detail
+	{
+		// The value of count digits starting at text[from], or -1 if any
+		// of them is not a digit.
+		constexpr int read_digits(std::string_view text, std::size_t from, std::size_t count)
+		{
+			int value = 0;
+			for (std::size_t i = from; i < from + count; ++i) {
+				const unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+				if (digit > 9) {
+					return -1;
+				}
+				value = value * 10 + static_cast<int>(digit);
+			}
+			return value;
+		}
+	}
+
+	// Reads exactly YYYY-MM-DD, zero padded, straight from the characters
+	// with no locale or stream. Accepts the same dates as read_date does
+	// for that layout, and like it rejects dates that do not exist.
+	constexpr std::optional<std::chrono::year_month_day> parse_iso_date(std::string_view text)
+	{
+		if (text.size() != 10 || text[4] != '-' || text[7] != '-') {
+			return {};
+		}
+		const int y = detail::read_digits(text, 0, 4);
+		const int m = detail::read_digits(text, 5, 2);
+		const int d = detail::read_digits(text, 8, 2);
+		if (y < 0 || m < 0 || d < 0) {
+			return {};
+		}
+		const std::chrono::year_month_day date{ std::chrono::year(y),
+			std::chrono::month(static_cast<unsigned>(m)),
+			std::chrono::day(static_cast<unsigned>(d)) };
+		if (!date.ok()) {
+			return {};
+		}
+		return date;
+	}
+}
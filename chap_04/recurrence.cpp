@@ -0,0 +1,36 @@
+#include "recurrence.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace dates
+{
+	CalendarIndex::CalendarIndex(std::span<const Rule> rules, std::chrono::year first, std::chrono::year last)
+	{
+		if (!first.ok() || !last.ok() || last < first) {
+			throw std::invalid_argument("CalendarIndex needs a valid year range");
+		}
+		std::vector<Occurrence> all;
+		for (std::size_t rule = 0; rule < rules.size(); ++rule) {
+			for_each_occurrence(rules[rule], static_cast<int>(first), static_cast<int>(last),
+				[&](std::chrono::sys_days day) { all.push_back({ day, rule }); });
+		}
+		// Stable, so rules falling on the same day keep the order given.
+		std::ranges::stable_sort(all, {}, &Occurrence::day);
+		days_.reserve(all.size());
+		rules_.reserve(all.size());
+		for (const auto& occurrence : all) {
+			days_.push_back(occurrence.day);
+			rules_.push_back(static_cast<std::uint32_t>(occurrence.rule));
+		}
+	}
+
+	std::optional<CalendarIndex::Occurrence> CalendarIndex::next_after(std::chrono::system_clock::time_point t) const
+	{
+		const std::size_t found = detail::upper_bound(days_, std::chrono::floor<std::chrono::days>(t));
+		if (found == days_.size()) {
+			return {};
+		}
+		return Occurrence{ days_[found], rules_[found] };
+	}
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dates
+{
+	// One day a month, or one day a year for fixed dates. Plain members,
+	// so a rule can be a template argument for the tables below.
+	struct Rule
+	{
+		enum class Kind : std::uint8_t
+		{
+			LastWeekday, // Friday[last]
+			NthWeekday,  // Friday[2]; months without one are skipped
+			LastDay,     // month / last
+			Fixed        // December / 31; skipped in years without it
+		};
+
+		Kind kind = Kind::LastDay;
+		unsigned day_of_week = 0; // C encoding, Sunday is 0
+		unsigned index = 0;
+		unsigned month = 0;
+		unsigned day = 0;
+
+		static constexpr Rule last_weekday(std::chrono::weekday wd)
+		{
+			return { Kind::LastWeekday, wd.c_encoding() };
+		}
+
+		static constexpr Rule nth_weekday(std::chrono::weekday_indexed wdi)
+		{
+			return { Kind::NthWeekday, wdi.weekday().c_encoding(), wdi.index() };
+		}
+
+		static constexpr Rule last_day()
+		{
+			return { Kind::LastDay };
+		}
+
+		static constexpr Rule fixed(std::chrono::month_day md)
+		{
+			return { Kind::Fixed, 0, 0, static_cast<unsigned>(md.month()), static_cast<unsigned>(md.day()) };
+		}
+
+		constexpr std::optional<std::chrono::sys_days> occurrence(std::chrono::year_month ym) const
+		{
+			using namespace std::chrono;
+			switch (kind)
+			{
+			case Kind::LastWeekday:
+				return sys_days{ ym / weekday(day_of_week)[last] };
+			case Kind::NthWeekday:
+				if (const auto date = ym / weekday(day_of_week)[index]; date.ok()) {
+					return sys_days{ date };
+				}
+				return {};
+			case Kind::LastDay:
+				return sys_days{ ym / std::chrono::last };
+			case Kind::Fixed:
+				if (const auto date = ym / std::chrono::day(this->day);
+					ym.month() == std::chrono::month(this->month) && date.ok()) {
+					return sys_days{ date };
+				}
+				return {};
+			default:
+				return {};
+			}
+		}
+
+		friend constexpr bool operator==(const Rule&, const Rule&) = default;
+	};
+
+	// Calls f with each occurrence from the start of first to the end of
+	// last, in order.
+	template<typename F>
+	constexpr void for_each_occurrence(const Rule& rule, int first, int last, F f)
+	{
+		using namespace std::chrono;
+		for (int y = first; y <= last; ++y) {
+			for (unsigned m = 1; m <= 12; ++m) {
+				if (auto day = rule.occurrence(year(y) / month(m))) {
+					f(*day);
+				}
+			}
+		}
+	}
+
+	constexpr std::size_t count_occurrences(const Rule& rule, int first, int last)
+	{
+		std::size_t count = 0;
+		for_each_occurrence(rule, first, last, [&count](std::chrono::sys_days) { ++count; });
+		return count;
+	}
+
+	// Every occurrence of one rule over a range of years, sorted,
+	// worked out by the compiler.
+	template<Rule rule, int first, int last>
+	constexpr auto occurrence_table = [] {
+		std::array<std::chrono::sys_days, count_occurrences(rule, first, last)> table{};
+		std::size_t i = 0;
+		for_each_occurrence(rule, first, last, [&](std::chrono::sys_days day) { table[i++] = day; });
+		return table;
+	}();
+
+	namespace detail
+	{
+		// std::upper_bound with the branch replaced by a conditional move:
+		// the loop always runs log n times, so nothing is mispredicted.
+		constexpr std::size_t upper_bound(std::span<const std::chrono::sys_days> days, std::chrono::sys_days day)
+		{
+			if (days.empty()) {
+				return 0;
+			}
+			std::size_t low = 0;
+			std::size_t n = days.size();
+			while (n > 1) {
+				const std::size_t half = n / 2;
+				low = days[low + half - 1] <= day ? low + half : low;
+				n -= half;
+			}
+			return low + (days[low] <= day);
+		}
+	}
+
+	// The first day in the sorted days that starts after t. A whole day
+	// starts after t exactly when it is later than t's day, and comparing
+	// days avoids converting far dates to t's finer duration.
+	constexpr std::optional<std::chrono::sys_days> next_after(
+		std::span<const std::chrono::sys_days> days, std::chrono::system_clock::time_point t)
+	{
+		const std::size_t found = detail::upper_bound(days, std::chrono::floor<std::chrono::days>(t));
+		if (found == days.size()) {
+			return {};
+		}
+		return days[found];
+	}
+
+	constexpr auto pay_days = occurrence_table<Rule::last_weekday(std::chrono::Friday), 2000, 2099>;
+	constexpr auto month_ends = occurrence_table<Rule::last_day(), 2000, 2099>;
+	constexpr auto new_years_eves = occurrence_table<Rule::fixed(std::chrono::December / 31), 2000, 2099>;
+
+	// The occurrences of several rules over a range of years, merged into
+	// one sorted array of days with a parallel array saying which rule
+	// each came from.
+	class CalendarIndex
+	{
+	public:
+		struct Occurrence
+		{
+			std::chrono::sys_days day;
+			std::size_t rule;
+		};
+
+		CalendarIndex(std::span<const Rule> rules, std::chrono::year first, std::chrono::year last);
+
+		std::size_t size() const { return days_.size(); }
+
+		std::span<const std::chrono::sys_days> days() const { return days_; }
+
+		// The first occurrence starting after t, found by binary search.
+		std::optional<Occurrence> next_after(std::chrono::system_clock::time_point t) const;
+	private:
+		std::vector<std::chrono::sys_days> days_;
+		std::vector<std::uint32_t> rules_;
+	};
+}
@@ -0,0 +1,203 @@
+#include "timer_wheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace timers
+{
+	void Lateness::add(double seconds)
+	{
+		++count;
+		const double delta = seconds - mean_seconds;
+		mean_seconds += delta / static_cast<double>(count);
+		sum_of_squares += delta * (seconds - mean_seconds);
+		worst_seconds = std::max(worst_seconds, seconds);
+	}
+
+	double Lateness::jitter() const
+	{
+		return count ? std::sqrt(sum_of_squares / static_cast<double>(count)) : 0;
+	}
+
+	TimerWheel::TimerWheel(clock::duration tick, clock::time_point start) :
+		tick_(tick),
+		start_(start)
+	{
+		if (tick <= clock::duration::zero()) {
+			throw std::invalid_argument("TimerWheel needs a positive tick");
+		}
+		for (auto& level : heads_) {
+			level.fill(none);
+		}
+	}
+
+	std::uint64_t TimerWheel::to_tick(clock::time_point time, bool round_up) const
+	{
+		if (time <= start_) {
+			return 0;
+		}
+		const auto since_start = time - start_;
+		const auto ticks = static_cast<std::uint64_t>(since_start / tick_);
+		return round_up && since_start % tick_ != clock::duration::zero() ? ticks + 1 : ticks;
+	}
+
+	Timer TimerWheel::schedule(clock::time_point deadline, std::function<void()> callback)
+	{
+		std::uint32_t index;
+		if (free_.empty()) {
+			index = static_cast<std::uint32_t>(events_.size());
+			events_.emplace_back();
+		}
+		else {
+			index = free_.back();
+			free_.pop_back();
+		}
+		Event& event = events_[index];
+		// Never before the current tick, and never early.
+		event.tick = std::max(to_tick(deadline, true), current_);
+		event.deadline = deadline;
+		event.callback = std::move(callback);
+		event.scheduled = true;
+		place(index);
+		++size_;
+		return { index, event.generation };
+	}
+
+	bool TimerWheel::cancel(Timer timer)
+	{
+		if (timer.index >= events_.size()) {
+			return false;
+		}
+		Event& event = events_[timer.index];
+		if (!event.scheduled || event.generation != timer.generation) {
+			return false;
+		}
+		unlink(timer.index);
+		event.scheduled = false;
+		event.callback = nullptr;
+		++event.generation;
+		free_.push_back(timer.index);
+		--size_;
+		return true;
+	}
+
+	void TimerWheel::place(std::uint32_t index)
+	{
+		Event& event = events_[index];
+		const std::uint64_t differs = event.tick ^ current_;
+		const int level = differs ? (std::bit_width(differs) - 1) / slot_bits : 0;
+		const auto slot = static_cast<std::size_t>((event.tick >> (level * slot_bits)) & (slots - 1));
+		event.level = static_cast<std::uint8_t>(level);
+		event.slot = static_cast<std::uint8_t>(slot);
+		event.previous = none;
+		event.next = heads_[level][slot];
+		if (event.next != none) {
+			events_[event.next].previous = index;
+		}
+		heads_[level][slot] = index;
+		occupied_[level] |= std::uint64_t{ 1 } << slot;
+	}
+
+	void TimerWheel::unlink(std::uint32_t index)
+	{
+		Event& event = events_[index];
+		if (event.previous != none) {
+			events_[event.previous].next = event.next;
+		}
+		else {
+			heads_[event.level][event.slot] = event.next;
+			if (event.next == none) {
+				occupied_[event.level] &= ~(std::uint64_t{ 1 } << event.slot);
+			}
+		}
+		if (event.next != none) {
+			events_[event.next].previous = event.previous;
+		}
+		event.previous = none;
+		event.next = none;
+	}
+
+	// Every event shares the current tick's digits above its level, and
+	// its digit at that level is later than the current one, so the
+	// lowest occupied level holds the earliest work.
+	std::optional<TimerWheel::Wakeup> TimerWheel::next_work() const
+	{
+		for (int level = 0; level < levels; ++level) {
+			const int shift = level * slot_bits;
+			const auto position = static_cast<int>((current_ >> shift) & (slots - 1));
+			const int first = level == 0 ? position : position + 1;
+			if (first >= static_cast<int>(slots)) {
+				continue;
+			}
+			const std::uint64_t waiting = occupied_[level] & (~std::uint64_t{ 0 } << first);
+			if (!waiting) {
+				continue;
+			}
+			const int above = shift + slot_bits;
+			const std::uint64_t prefix = above >= 64 ? 0 : current_ >> above << above;
+			const auto slot = static_cast<std::uint64_t>(std::countr_zero(waiting));
+			return Wakeup{ prefix | (slot << shift), level };
+		}
+		return {};
+	}
+
+	std::size_t TimerWheel::advance(clock::time_point now)
+	{
+		const std::uint64_t target = to_tick(now, false);
+		std::size_t fired = 0;
+		for (auto work = next_work(); work && work->tick <= target; work = next_work()) {
+			current_ = work->tick;
+			const int shift = work->level * slot_bits;
+			auto& head = heads_[work->level][(current_ >> shift) & (slots - 1)];
+			if (work->level > 0) {
+				while (head != none) {
+					const std::uint32_t index = head;
+					unlink(index);
+					place(index);
+				}
+				continue;
+			}
+			// Callbacks may schedule or cancel, even in this slot.
+			while (head != none) {
+				const std::uint32_t index = head;
+				unlink(index);
+				Event& event = events_[index];
+				auto callback = std::move(event.callback);
+				const auto deadline = event.deadline;
+				event.callback = nullptr;
+				event.scheduled = false;
+				++event.generation;
+				free_.push_back(index);
+				--size_;
+				const std::chrono::duration<double> late = clock::now() - deadline;
+				lateness_.add(late.count());
+				callback();
+				++fired;
+			}
+		}
+		current_ = std::max(current_, target);
+		return fired;
+	}
+
+	std::optional<TimerWheel::clock::time_point> TimerWheel::next_wakeup() const
+	{
+		if (auto work = next_work()) {
+			return start_ + tick_ * static_cast<clock::rep>(work->tick);
+		}
+		return {};
+	}
+
+	void TimerWheel::run()
+	{
+		while (!empty()) {
+			if (auto wakeup = next_wakeup()) {
+				std::this_thread::sleep_until(*wakeup);
+			}
+			advance(clock::now());
+		}
+	}
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace timers
+{
+	// Identifies a scheduled event; stale once it has fired or been
+	// cancelled, even if its slot is reused.
+	struct Timer
+	{
+		std::uint32_t index;
+		std::uint32_t generation;
+	};
+
+	// How late callbacks ran compared with their deadlines.
+	struct Lateness
+	{
+		std::size_t count = 0;
+		double mean_seconds = 0;
+		double sum_of_squares = 0;
+		double worst_seconds = 0;
+
+		void add(double seconds);
+
+		// The steady part of the lateness.
+		double drift() const { return mean_seconds; }
+		// The standard deviation about the drift.
+		double jitter() const;
+	};
+
+	// A hierarchical timer wheel over steady_clock ticks. Each level has
+	// 64 slots, each 64 times as wide as a slot in the level below, and
+	// an event sits at the level of the highest base 64 digit in which
+	// its deadline differs from the current tick. Scheduling and
+	// cancelling are O(1). As time passes an event's slot is emptied
+	// into lower levels until it reaches level 0 and fires.
+	class TimerWheel
+	{
+	public:
+		using clock = std::chrono::steady_clock;
+
+		explicit TimerWheel(clock::duration tick = std::chrono::milliseconds{ 1 },
+			clock::time_point start = clock::now());
+
+		// Deadlines already past fire on the next advance.
+		Timer schedule(clock::time_point deadline, std::function<void()> callback);
+
+		// False if the event has already fired or been cancelled.
+		bool cancel(Timer timer);
+
+		std::size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+
+		// Runs every callback whose deadline tick has been reached by now,
+		// in deadline order at tick resolution. Returns how many ran.
+		std::size_t advance(clock::time_point now);
+
+		// When advance next has work to do: a deadline, or a slot to empty.
+		std::optional<clock::time_point> next_wakeup() const;
+
+		// Sleeps until each wakeup and advances, until no events are left.
+		void run();
+
+		const Lateness& lateness() const { return lateness_; }
+	private:
+		static constexpr int slot_bits = 6;
+		static constexpr std::size_t slots = std::size_t{ 1 } << slot_bits;
+		static constexpr int levels = (64 + slot_bits - 1) / slot_bits;
+		static constexpr std::uint32_t none = ~std::uint32_t{ 0 };
+
+		struct Event
+		{
+			std::uint64_t tick = 0;
+			clock::time_point deadline;
+			std::function<void()> callback;
+			std::uint32_t previous = none;
+			std::uint32_t next = none;
+			std::uint32_t generation = 0;
+			std::uint8_t level = 0;
+			std::uint8_t slot = 0;
+			bool scheduled = false;
+		};
+
+		struct Wakeup
+		{
+			std::uint64_t tick;
+			int level;
+		};
+
+		std::uint64_t to_tick(clock::time_point time, bool round_up) const;
+		std::optional<Wakeup> next_work() const;
+		void place(std::uint32_t index);
+		void unlink(std::uint32_t index);
+
+		clock::duration tick_;
+		clock::time_point start_;
+		std::uint64_t current_ = 0;
+		std::vector<Event> events_;
+		std::vector<std::uint32_t> free_;
+		std::array<std::array<std::uint32_t, slots>, levels> heads_;
+		std::array<std::uint64_t, levels> occupied_{};
+		std::size_t size_ = 0;
+		Lateness lateness_;
+	};
+}
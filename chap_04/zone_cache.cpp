@@ -0,0 +1,102 @@
+#include "zone_cache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace dates
+{
+	ZoneCache::ZoneCache(const std::chrono::time_zone* zone, std::chrono::year first, std::chrono::year last) :
+		zone_(zone)
+	{
+		using namespace std::chrono;
+		if (!zone) {
+			throw std::invalid_argument("ZoneCache needs a time zone");
+		}
+		if (!first.ok() || !last.ok() || last < first) {
+			throw std::invalid_argument("ZoneCache needs a valid year range");
+		}
+		// Local times from the start of first to the end of last are cached.
+		// No UTC offset reaches a day, so the periods from a day either side
+		// cover them, and nothing outside can overlap them.
+		const local_seconds cache_begin = local_days{ first / January / 1 };
+		const local_seconds cache_end = local_days{ (last + years{ 1 }) / January / 1 };
+		const sys_seconds from{ cache_begin.time_since_epoch() - days{ 1 } };
+		const sys_seconds to{ cache_end.time_since_epoch() + days{ 1 } };
+
+		std::vector<sys_info> infos{ zone_->get_info(from) };
+		while (infos.back().end < to) {
+			infos.push_back(zone_->get_info(infos.back().end));
+		}
+
+		// Each period's local range, trimmed where it meets a neighbour so
+		// that repeated local times are left out, as are skipped ones.
+		offsets_.reserve(infos.size());
+		for (std::size_t i = 0; i < infos.size(); ++i) {
+			const auto& info = infos[i];
+			// Clamped first, as zones without changes run from min to max.
+			local_seconds begin{ std::max(info.begin, from).time_since_epoch() + info.offset };
+			local_seconds end{ std::min(info.end, to).time_since_epoch() + info.offset };
+			if (i == 0) {
+				begin = std::max(begin, cache_begin);
+			}
+			else {
+				const auto& before = infos[i - 1];
+				begin = std::max(begin, local_seconds{ before.end.time_since_epoch() + before.offset });
+			}
+			if (i + 1 < infos.size()) {
+				const auto& after = infos[i + 1];
+				end = std::min(end, local_seconds{ after.begin.time_since_epoch() + after.offset });
+			}
+			else {
+				end = std::min(end, cache_end);
+			}
+			if (begin < end) {
+				offsets_.push_back({ begin, end, info.offset });
+			}
+		}
+		assert(std::ranges::is_sorted(offsets_, {}, &Offset::begin));
+	}
+
+	ZoneCache::ZoneCache(std::chrono::year first, std::chrono::year last) :
+		ZoneCache(std::chrono::current_zone(), first, last)
+	{
+	}
+
+	std::chrono::sys_seconds ZoneCache::to_sys(std::chrono::local_seconds local) const
+	{
+		using namespace std::chrono;
+		auto after = std::ranges::upper_bound(offsets_, local, {}, &Offset::begin);
+		if (after != offsets_.begin() && in(*(after - 1), local)) {
+			return sys_seconds{ local.time_since_epoch() - (after - 1)->offset };
+		}
+		// Outside the cached years, or a time the clocks skip or repeat:
+		// the zone itself gives the answer or throws.
+		return zoned_time(zone_, local).get_sys_time();
+	}
+
+	void ZoneCache::to_sys(std::span<const std::chrono::local_days> dates,
+		std::span<std::chrono::sys_seconds> sys_times) const
+	{
+		using namespace std::chrono;
+		if (sys_times.size() != dates.size()) {
+			throw std::invalid_argument("to_sys needs one output per date");
+		}
+		const Offset* last = nullptr;
+		for (std::size_t i = 0; i < dates.size(); ++i) {
+			const local_seconds local = dates[i];
+			if (last && in(*last, local)) {
+				sys_times[i] = sys_seconds{ local.time_since_epoch() - last->offset };
+				continue;
+			}
+			auto after = std::ranges::upper_bound(offsets_, local, {}, &Offset::begin);
+			if (after != offsets_.begin() && in(*(after - 1), local)) {
+				last = &*(after - 1);
+				sys_times[i] = sys_seconds{ local.time_since_epoch() - last->offset };
+			}
+			else {
+				sys_times[i] = to_sys(local);
+			}
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace dates
+{
+	// A time zone looked up once, with its UTC offset changes over a
+	// range of years kept in one sorted array. Turning a local time into
+	// a system time is then a binary search instead of a tzdb search.
+	// Gives the same results as zoned_time(zone, local).get_sys_time(),
+	// including the exceptions for times that are skipped or repeated.
+	class ZoneCache
+	{
+	public:
+		ZoneCache(const std::chrono::time_zone* zone, std::chrono::year first, std::chrono::year last);
+
+		// The current zone, resolved once here.
+		ZoneCache(std::chrono::year first, std::chrono::year last);
+
+		const std::chrono::time_zone* zone() const { return zone_; }
+
+		std::size_t transitions() const { return offsets_.size(); }
+
+		std::chrono::sys_seconds to_sys(std::chrono::local_seconds local) const;
+
+		// Converts every date; sys_times must be the same size as dates.
+		// Runs of nearby dates reuse the last offset found.
+		void to_sys(std::span<const std::chrono::local_days> dates,
+			std::span<std::chrono::sys_seconds> sys_times) const;
+	private:
+		// Local times from begin up to end use offset, and there is no
+		// other offset that could also apply.
+		struct Offset
+		{
+			std::chrono::local_seconds begin;
+			std::chrono::local_seconds end;
+			std::chrono::seconds offset;
+		};
+
+		bool in(const Offset& offset, std::chrono::local_seconds local) const
+		{
+			return offset.begin <= local && local < offset.end;
+		}
+
+		const std::chrono::time_zone* zone_;
+		std::vector<Offset> offsets_;
+	};
+}
@@ -1,5 +1,262 @@
+#include "packed_card.h"
 #include "playing_cards.h"
+#include "poker.h"
+#include "shoe.h"
+#include "shuffler.h"
+#include "simulator.h"
 
-int main() {
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <span>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+template <typename F>
+double seconds_taken(F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+
+// Every neighbouring pair of a million dealt cards, checked with both
+// the variant and the packed cards.
+void benchmark_guesses(std::ostream& os) {
+	constexpr std::size_t count = 1'000'000;
+	const auto deck = cards::create_extended_deck();
+	std::mt19937 engine(2026);
+	std::uniform_int_distribution<std::size_t> index(0, deck.size() - 1);
+	std::vector<std::variant<cards::Card, cards::Joker>> dealt(count);
+	std::vector<cards::PackedCard> packed(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		dealt[i] = deck[index(engine)];
+		packed[i] = dealt[i];
+	}
+
+	os << std::format("{:>28} {:>14} {:>14}\n", "cards", "bytes/card", "guesses/sec");
+	auto report = [&os](std::string_view name, std::size_t bytes, const auto& hand) {
+		std::size_t correct = 0;
+		double taken = seconds_taken([&] {
+			for (std::size_t i = 0; i + 1 < hand.size(); ++i) {
+				correct += cards::is_guess_correct('h', hand[i], hand[i + 1]);
+			}
+			});
+		os << std::format("{:>28} {:>14} {:>14.0f}\n", name, bytes, (hand.size() - 1) / taken);
+		return correct;
+	};
+	const std::size_t by_variant = report("std::variant<Card, Joker>", sizeof(dealt[0]), dealt);
+	const std::size_t by_code = report("PackedCard", sizeof(packed[0]), packed);
+	assert(by_variant == by_code);
+}
+
+// The old shuffle_deck: a fresh random_device and mt19937 every time.
+void reseeded_shuffle(cards::PackedDeck& deck) {
+	std::random_device rd;
+	std::mt19937 gen{ rd() };
+	std::ranges::shuffle(deck, gen);
+}
+
+void benchmark_shuffles(std::ostream& os) {
+	constexpr std::size_t count = 100'000;
+	std::vector<cards::PackedDeck> decks(count, cards::create_packed_deck());
+	auto variants = cards::create_extended_deck();
+	std::mt19937 kept{ 2026 };
+
+	os << std::format("{:>44} {:>14}\n", "shuffle", "shuffles/sec");
+	auto report = [&os](std::string_view name, std::size_t shuffles, auto shuffle) {
+		double taken = seconds_taken(shuffle);
+		os << std::format("{:>44} {:>14.0f}\n", name, shuffles / taken);
+	};
+	report("random_device and mt19937 per shuffle", count / 10, [&] {
+		for (std::size_t i = 0; i < count / 10; ++i) {
+			reseeded_shuffle(decks[i]);
+		}
+		});
+	report("std::ranges::shuffle, one mt19937", count, [&] {
+		for (auto& deck : decks) {
+			std::ranges::shuffle(deck, kept);
+		}
+		});
+	report("shuffle_deck, variant cards", count, [&] {
+		for (std::size_t i = 0; i < count; ++i) {
+			cards::shuffle_deck(variants);
+		}
+		});
+	report("shuffle_deck, packed cards", count, [&] {
+		for (auto& deck : decks) {
+			cards::shuffle_deck(deck);
+		}
+		});
+	report("Shuffler::shuffle_each", count, [&] {
+		cards::Shuffler::local().shuffle_each(decks);
+		});
+}
+
+// Plays each policy headless and prints the share of games ending on
+// each streak.
+void compare_policies(std::ostream& os, std::uint64_t games) {
+	using simulator::Policy;
+	constexpr std::array policies{ Policy::Naive, Policy::Midpoint, Policy::Counting };
+	std::array<simulator::Report, policies.size()> reports;
+	for (std::size_t i = 0; i < policies.size(); ++i) {
+		reports[i] = simulator::simulate(policies[i], games, 2026);
+		os << std::format("{:>16}: mean streak {:.3f}, longest {}, {:.0f} games/sec\n",
+			simulator::to_string(policies[i]), reports[i].mean(), reports[i].longest(),
+			reports[i].games_per_second());
+	}
+
+	os << std::format("\n{:>8}", "streak");
+	for (auto policy : policies) {
+		os << std::format(" {:>14}", simulator::to_string(policy));
+	}
+	os << '\n';
+	for (std::size_t streak = 0; streak <= simulator::longest_streak; ++streak) {
+		if (std::ranges::all_of(reports, [streak](const auto& report) { return report.streak_counts[streak] == 0; })) {
+			continue;
+		}
+		os << std::format("{:>8}", streak);
+		for (const auto& report : reports) {
+			os << std::format(" {:>13.4f}%", 100.0 * report.streak_counts[streak] / report.games);
+		}
+		os << '\n';
+	}
+}
+
+// Evaluates all C(52, 5) hands, then works out the equity of two
+// pocket pairs before the flop, every board dealt.
+void benchmark_poker(std::ostream& os) {
+	std::array<std::uint64_t, 9> counts{};
+	double taken = seconds_taken([&counts] { counts = poker::count_five_card_hands(); });
+	std::uint64_t hands = 0;
+	for (std::size_t i = 0; i < counts.size(); ++i) {
+		os << std::format("{:>16}: {}\n", poker::to_string(static_cast<poker::Category>(i)), counts[i]);
+		hands += counts[i];
+	}
+	os << std::format("{} five card hands, {:.0f} hands/sec\n\n", hands, hands / taken);
+
+	using cards::Card;
+	using cards::FaceValue;
+	using cards::Suit;
+	const std::array<poker::Hole, 2> players{ {
+		{ Card{ FaceValue(1), Suit::Spades }, Card{ FaceValue(1), Suit::Hearts } },
+		{ Card{ FaceValue(13), Suit::Clubs }, Card{ FaceValue(13), Suit::Diamonds } } } };
+	const auto equity = poker::equity(players, {});
+	for (std::size_t p = 0; p < players.size(); ++p) {
+		os << players[p][0] << ", " << players[p][1] << std::format(": {:.2f}%\n", 100 * equity.shares[p]);
+	}
+	os << std::format("{} boards, {:.0f} boards/sec\n", equity.boards, equity.boards_per_second());
+}
+
+// Deals five card hands from decks of cards, either shuffling every
+// card before each hand or drawing from a shoe that reshuffles at its
+// cut card.
+void benchmark_shoe(std::ostream& os, std::size_t decks) {
+	constexpr std::size_t hands = 200'000;
+	constexpr std::size_t hand_size = 5;
+	std::size_t codes = 0; // keeps the hands from being optimised away
+
+	os << std::format("{} decks, {} card hands\n", decks, hand_size);
+	os << std::format("{:>36} {:>14}\n", "deal", "hands/sec");
+	auto report = [&os](std::string_view name, auto deal) {
+		double taken = seconds_taken(deal);
+		os << std::format("{:>36} {:>14.0f}\n", name, hands / taken);
+	};
+
+	report("shuffle_deck on each deck", [&] {
+		std::vector<std::array<std::variant<cards::Card, cards::Joker>, 54>> shoe(decks);
+		for (std::size_t hand = 0; hand < hands; ++hand) {
+			for (auto& deck : shoe) {
+				deck = cards::create_extended_deck();
+				cards::shuffle_deck(deck);
+			}
+			for (std::size_t card = 0; card < hand_size; ++card) {
+				codes += cards::PackedCard{ shoe[card % decks][card / decks] }.code();
+			}
+		}
+		});
+	report("Shuffler on the whole shoe", [&] {
+		std::vector<cards::PackedCard> shoe;
+		for (std::size_t deck = 0; deck < decks; ++deck) {
+			const auto packed = cards::create_packed_deck();
+			shoe.insert(shoe.end(), packed.begin(), packed.end());
+		}
+		for (std::size_t hand = 0; hand < hands; ++hand) {
+			cards::Shuffler::local().shuffle(shoe);
+			for (std::size_t card = 0; card < hand_size; ++card) {
+				codes += shoe[card].code();
+			}
+		}
+		});
+	std::size_t reshuffles = 0;
+	report("Shoe, reshuffled at the cut card", [&] {
+		cards::Shoe shoe(decks);
+		for (std::size_t hand = 0; hand < hands; ++hand) {
+			if (shoe.past_cut()) {
+				shoe.reshuffle();
+				++reshuffles;
+			}
+			for (std::size_t card = 0; card < hand_size; ++card) {
+				codes += shoe.draw().code();
+			}
+		}
+		});
+	os << std::format("{} reshuffles, checksum {}\n", reshuffles, codes);
+}
+
+// A whole number from first to last, or nothing if text is anything else.
+std::optional<std::uint64_t> parse_count(std::string_view text, std::uint64_t first, std::uint64_t last) {
+	std::uint64_t value = 0;
+	auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+	if (ec != std::errc{} || end != text.data() + text.size() || value < first || value > last) {
+		return {};
+	}
+	return value;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc > 1 && std::string_view(argv[1]) == "--bench") {
+		cards::check_packed_cards();
+		benchmark_guesses(std::cout);
+		return 0;
+	}
+	if (argc > 1 && std::string_view(argv[1]) == "--shuffle") {
+		cards::check_shuffler();
+		benchmark_shuffles(std::cout);
+		return 0;
+	}
+	if (argc > 1 && std::string_view(argv[1]) == "--simulate") {
+		constexpr std::uint64_t max_games = 10'000'000'000;
+		const auto games = argc > 2 ? parse_count(argv[2], 1, max_games) : 1'000'000;
+		if (!games) {
+			std::cerr << std::format("Usage: higher_lower --simulate [games], with 1 to {} games\n", max_games);
+			return 1;
+		}
+		compare_policies(std::cout, *games);
+		return 0;
+	}
+	if (argc > 1 && std::string_view(argv[1]) == "--poker") {
+		poker::check_poker();
+		benchmark_poker(std::cout);
+		return 0;
+	}
+	if (argc > 1 && std::string_view(argv[1]) == "--shoe") {
+		constexpr std::uint64_t max_decks = 64;
+		const auto decks = argc > 2 ? parse_count(argv[2], 1, max_decks) : 6;
+		if (!decks) {
+			std::cerr << std::format("Usage: higher_lower --shoe [decks], with 1 to {} decks\n", max_decks);
+			return 1;
+		}
+		cards::check_shoe();
+		benchmark_shoe(std::cout, static_cast<std::size_t>(*decks));
+		return 0;
+	}
 	cards::higher_lower_with_jokers();
-}
\ No newline at end of file
+}
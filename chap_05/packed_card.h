@@ -0,0 +1,145 @@
+#pragma once
+
+#include "playing_cards.h"
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <variant>
+
+namespace cards
+{
+	// A card or joker in one byte. Cards are (value - 1) * 4 + suit, so
+	// comparing codes orders cards as Card's <=> does, by value then
+	// suit, with no branches. The code after the 52 cards is the joker.
+	class PackedCard
+	{
+	public:
+		static constexpr std::uint8_t joker_code = 52;
+
+		constexpr PackedCard() = default;
+
+		constexpr PackedCard(const Card& card) :
+			code_(static_cast<std::uint8_t>((card.value().value() - 1) * 4 + static_cast<int>(card.suit())))
+		{
+		}
+
+		constexpr PackedCard(Joker) : code_(joker_code)
+		{
+		}
+
+		constexpr PackedCard(const std::variant<Card, Joker>& card) :
+			code_(std::holds_alternative<Joker>(card) ? joker_code : PackedCard(std::get<Card>(card)).code_)
+		{
+		}
+
+		constexpr std::uint8_t code() const { return code_; }
+
+		constexpr bool is_joker() const { return code_ == joker_code; }
+
+		// Only for cards that are not the joker.
+		constexpr Card card() const
+		{
+			return Card{ FaceValue(code_ / 4 + 1), static_cast<Suit>(code_ % 4) };
+		}
+
+		constexpr std::variant<Card, Joker> variant() const
+		{
+			if (is_joker()) {
+				return Joker{};
+			}
+			return card();
+		}
+
+		auto operator<=>(const PackedCard&) const = default;
+	private:
+		std::uint8_t code_ = 0;
+	};
+
+	static_assert(sizeof(PackedCard) == 1);
+
+	namespace detail
+	{
+		constexpr std::uint8_t wild_rank = 0xff;
+
+		// Each code's place in the higher or lower order, with the joker
+		// marked wild. Unused codes are wild too.
+		constexpr std::array<std::uint8_t, 256> ranks = [] {
+			std::array<std::uint8_t, 256> table{};
+			for (std::size_t code = 0; code < table.size(); ++code) {
+				table[code] = code < PackedCard::joker_code ? static_cast<std::uint8_t>(code) : wild_rank;
+			}
+			return table;
+		}();
+	}
+
+	// The same answers as the variant overload, from two table lookups.
+	constexpr bool is_guess_correct(char guess, PackedCard current, PackedCard next)
+	{
+		const unsigned from = detail::ranks[current.code()];
+		const unsigned to = detail::ranks[next.code()];
+		const bool wild = (from == detail::wild_rank) | (to == detail::wild_rank);
+		return wild | ((guess == 'h') & (to > from)) | ((guess == 'l') & (to < from));
+	}
+
+	// The extended deck, 54 bytes, in one cache line.
+	struct alignas(64) PackedDeck
+	{
+		std::array<PackedCard, 54> cards;
+
+		constexpr auto begin() { return cards.begin(); }
+		constexpr auto end() { return cards.end(); }
+		constexpr auto begin() const { return cards.begin(); }
+		constexpr auto end() const { return cards.end(); }
+		constexpr std::size_t size() const { return cards.size(); }
+		constexpr PackedCard& operator[](std::size_t i) { return cards[i]; }
+		constexpr const PackedCard& operator[](std::size_t i) const { return cards[i]; }
+	};
+
+	static_assert(sizeof(PackedDeck) == 64);
+
+	// The same order as create_extended_deck: two jokers, then each suit
+	// from Ace to King.
+	constexpr PackedDeck create_packed_deck()
+	{
+		PackedDeck deck{};
+		deck[0] = Joker{};
+		deck[1] = Joker{};
+		std::size_t i = 2;
+		for (int suit = 0; suit < 4; ++suit) {
+			for (int value = 1; value <= 13; ++value) {
+				deck[i++] = Card{ FaceValue(value), static_cast<Suit>(suit) };
+			}
+		}
+		return deck;
+	}
+
+	constexpr PackedDeck to_packed(const std::array<std::variant<Card, Joker>, 54>& deck)
+	{
+		PackedDeck packed{};
+		for (std::size_t i = 0; i < deck.size(); ++i) {
+			packed[i] = deck[i];
+		}
+		return packed;
+	}
+
+	constexpr std::array<std::variant<Card, Joker>, 54> to_variants(const PackedDeck& deck)
+	{
+		std::array<std::variant<Card, Joker>, 54> variants;
+		for (std::size_t i = 0; i < deck.size(); ++i) {
+			variants[i] = deck[i].variant();
+		}
+		return variants;
+	}
+
+	inline std::ostream& operator<<(std::ostream& os, PackedCard card)
+	{
+		return os << card.variant();
+	}
+
+	void shuffle_deck(PackedDeck& deck);
+
+	void check_packed_cards();
+}
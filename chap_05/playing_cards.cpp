@@ -1,4 +1,8 @@
 #include "playing_cards.h"
+#include "packed_card.h"
+#include "shuffler.h"
+
+#include <cassert>
 
 namespace cards
 {
@@ -89,9 +93,12 @@ namespace cards
 
 	void shuffle_deck(std::array<std::variant<Card, Joker>, 54>& deck)
 	{
-		std::random_device rd;
-		std::mt19937 gen{ rd() };
-		std::ranges::shuffle(deck, gen);
+		Shuffler::local().shuffle(deck);
+	}
+
+	void shuffle_deck(PackedDeck& deck)
+	{
+		Shuffler::local().shuffle(deck);
 	}
 
 	bool is_guess_correct(char guess,
@@ -118,7 +125,7 @@ namespace cards
 
 	void higher_lower_with_jokers()
 	{
-		auto deck = create_extended_deck();
+		auto deck = create_packed_deck();
 		shuffle_deck(deck);
 
 		size_t index = 0;
@@ -145,4 +152,24 @@ namespace cards
 		std::ranges::copy(cards, deck.begin() + 2);
 		return deck;
 	}
+
+	void check_packed_cards()
+	{
+		const auto variants = create_extended_deck();
+		const PackedDeck packed = create_packed_deck();
+		assert(to_packed(variants).cards == packed.cards);
+		assert(to_packed(to_variants(packed)).cards == packed.cards);
+		for (const auto& current : variants) {
+			for (const auto& next : variants) {
+				const PackedCard a{ current };
+				const PackedCard b{ next };
+				if (!a.is_joker() && !b.is_joker()) {
+					assert((a <=> b) == (std::get<Card>(current) <=> std::get<Card>(next)));
+				}
+				for (char guess : { 'h', 'l', 'x' }) {
+					assert(is_guess_correct(guess, a, b) == is_guess_correct(guess, current, next));
+				}
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -22,7 +22,7 @@ namespace cards
 	class FaceValue
 	{
 	public:
-		explicit FaceValue(int value) : value_(value)
+		constexpr explicit FaceValue(int value) : value_(value)
 		{
 			if (value_ < 1 || value_ > 13)
 			{
@@ -31,7 +31,7 @@ namespace cards
 				);
 			}
 		}
-		int value() const
+		constexpr int value() const
 		{
 			return value_;
 		}
@@ -43,14 +43,14 @@ namespace cards
 	class Card
 	{
 	public:
-		Card() = default;
-		Card(FaceValue value, Suit suit) :
+		constexpr Card() = default;
+		constexpr Card(FaceValue value, Suit suit) :
 			value_(value),
 			suit_(suit)
 		{
 		}
-		FaceValue value() const { return value_; }
-		Suit suit() const { return suit_; }
+		constexpr FaceValue value() const { return value_; }
+		constexpr Suit suit() const { return suit_; }
 		auto operator<=>(const Card&) const = default;
 	private:
 		FaceValue value_{ 1 };
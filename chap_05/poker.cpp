@@ -0,0 +1,477 @@
+#include "poker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace poker
+{
+	namespace
+	{
+		constexpr int ranks = 13;
+		constexpr std::array<std::uint32_t, ranks> primes{ 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41 };
+
+		// How many hands of each category there are, weakest first.
+		constexpr std::array<Strength, 9> category_sizes{ 1277, 2860, 858, 858, 10, 1277, 156, 156, 10 };
+
+		constexpr std::size_t paired_hands = 2860 + 858 + 858 + 156 + 156;
+
+		// Cactus Kev's card: one bit for the rank at 16 + rank, one for
+		// the suit at 12 + suit, and the rank's prime in the low byte.
+		// Ranks run from 0 for a two to 12 for an ace.
+		using KevCard = std::uint32_t;
+
+		constexpr std::array<KevCard, cards::PackedCard::joker_code> kev_cards = [] {
+			std::array<KevCard, cards::PackedCard::joker_code> table{};
+			for (std::uint32_t code = 0; code < table.size(); ++code) {
+				const std::uint32_t rank = (code / 4 + 12) % ranks; // value 1, an ace, is highest
+				const std::uint32_t suit = code % 4;
+				table[code] = primes[rank] | rank << 8 | 1u << (12 + suit) | 1u << (16 + rank);
+			}
+			return table;
+		}();
+
+		constexpr bool is_straight(unsigned mask)
+		{
+			if (mask == 0x100f) { // A 2 3 4 5
+				return true;
+			}
+			for (int top = 4; top < ranks; ++top) {
+				if (mask == 0x1fu << (top - 4)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Five high first, ace high last.
+		constexpr std::array<unsigned, 10> straights{
+			0x100f, 0x1f, 0x3e, 0x7c, 0xf8, 0x1f0, 0x3e0, 0x7c0, 0xf80, 0x1f00 };
+
+		struct Tables
+		{
+			// By the ranks present, for five different ranks.
+			std::array<Strength, 1 << ranks> flushes{};
+			std::array<Strength, 1 << ranks> unique_ranks{};
+			// By the product of the rank primes, for hands with a pair,
+			// sorted so they can be binary searched.
+			std::array<std::uint32_t, paired_hands> products{};
+			std::array<Strength, paired_hands> product_strengths{};
+		};
+
+		// Hands within a category are listed weakest first. For sets of
+		// ranks of the same size, comparing as bit masks compares the
+		// highest rank first, then the next, as poker does.
+		constexpr Tables make_tables()
+		{
+			Tables tables;
+			// Product above strength, so sorting sorts by product.
+			std::array<std::uint64_t, paired_hands> entries{};
+			std::size_t entry = 0;
+			Strength next = weakest;
+
+			// Each set of count ranks without the excluded ones, in
+			// increasing order, stepping from one set of that size to the
+			// next with Gosper's hack.
+			auto for_each_kickers = [](int count, unsigned excluded, auto f) {
+				for (unsigned mask = (1u << count) - 1; mask < (1u << ranks);) {
+					if (!(mask & excluded)) {
+						f(mask);
+					}
+					const unsigned lowest = mask & (0u - mask);
+					const unsigned ripple = mask + lowest;
+					mask = ripple | (((mask ^ ripple) >> 2) / lowest);
+				}
+			};
+			auto product_of = [](unsigned mask) {
+				std::uint32_t product = 1;
+				for (int rank = 0; rank < ranks; ++rank) {
+					if (mask & (1u << rank)) {
+						product *= primes[rank];
+					}
+				}
+				return product;
+			};
+			auto add = [&](std::uint32_t product) {
+				entries[entry++] = std::uint64_t{ product } << 16 | next++;
+			};
+
+			for_each_kickers(5, 0, [&](unsigned mask) {
+				if (!is_straight(mask)) {
+					tables.unique_ranks[mask] = next++;
+				}
+				});
+			for (int pair = 0; pair < ranks; ++pair) {
+				for_each_kickers(3, 1u << pair, [&](unsigned kickers) {
+					add(primes[pair] * primes[pair] * product_of(kickers));
+					});
+			}
+			for (int high = 1; high < ranks; ++high) {
+				for (int low = 0; low < high; ++low) {
+					for (int kicker = 0; kicker < ranks; ++kicker) {
+						if (kicker != high && kicker != low) {
+							add(primes[high] * primes[high] * primes[low] * primes[low] * primes[kicker]);
+						}
+					}
+				}
+			}
+			for (int trips = 0; trips < ranks; ++trips) {
+				for_each_kickers(2, 1u << trips, [&](unsigned kickers) {
+					add(primes[trips] * primes[trips] * primes[trips] * product_of(kickers));
+					});
+			}
+			for (unsigned mask : straights) {
+				tables.unique_ranks[mask] = next++;
+			}
+			for_each_kickers(5, 0, [&](unsigned mask) {
+				if (!is_straight(mask)) {
+					tables.flushes[mask] = next++;
+				}
+				});
+			for (int trips = 0; trips < ranks; ++trips) {
+				for (int pair = 0; pair < ranks; ++pair) {
+					if (pair != trips) {
+						add(primes[trips] * primes[trips] * primes[trips] * primes[pair] * primes[pair]);
+					}
+				}
+			}
+			for (int quads = 0; quads < ranks; ++quads) {
+				for (int kicker = 0; kicker < ranks; ++kicker) {
+					if (kicker != quads) {
+						const std::uint32_t square = primes[quads] * primes[quads];
+						add(square * square * primes[kicker]);
+					}
+				}
+			}
+			for (unsigned mask : straights) {
+				tables.flushes[mask] = next++;
+			}
+
+			std::sort(entries.begin(), entries.end());
+			for (std::size_t i = 0; i < entries.size(); ++i) {
+				tables.products[i] = static_cast<std::uint32_t>(entries[i] >> 16);
+				tables.product_strengths[i] = static_cast<Strength>(entries[i]);
+			}
+			return tables;
+		}
+
+		constexpr Tables tables = make_tables();
+
+		static_assert(tables.flushes[0x1f00] == strongest);
+		static_assert(tables.unique_ranks[0x2f] == weakest); // 7 5 4 3 2
+		static_assert(std::ranges::adjacent_find(tables.products) == tables.products.end());
+
+		// The same search as std::lower_bound, without branches.
+		Strength find_product(std::uint32_t product)
+		{
+			std::size_t low = 0;
+			std::size_t n = tables.products.size();
+			while (n > 1) {
+				const std::size_t half = n / 2;
+				low = tables.products[low + half - 1] < product ? low + half : low;
+				n -= half;
+			}
+			return tables.product_strengths[low];
+		}
+
+		Strength evaluate(KevCard a, KevCard b, KevCard c, KevCard d, KevCard e)
+		{
+			const unsigned mask = (a | b | c | d | e) >> 16;
+			if (a & b & c & d & e & 0xf000) {
+				return tables.flushes[mask];
+			}
+			if (const Strength strength = tables.unique_ranks[mask]) {
+				return strength;
+			}
+			return find_product((a & 0xff) * (b & 0xff) * (c & 0xff) * (d & 0xff) * (e & 0xff));
+		}
+
+		// The 21 ways to leave out two of seven cards.
+		constexpr auto seven_choose_five = [] {
+			std::array<std::array<std::uint8_t, 5>, 21> choices{};
+			std::size_t i = 0;
+			for (std::uint8_t left_out = 0; left_out < 7; ++left_out) {
+				for (std::uint8_t also_left_out = left_out + 1; also_left_out < 7; ++also_left_out) {
+					std::size_t j = 0;
+					for (std::uint8_t card = 0; card < 7; ++card) {
+						if (card != left_out && card != also_left_out) {
+							choices[i][j++] = card;
+						}
+					}
+					++i;
+				}
+			}
+			return choices;
+		}();
+
+		Strength evaluate(const std::array<KevCard, 7>& hand)
+		{
+			Strength best = 0;
+			for (const auto& c : seven_choose_five) {
+				best = std::max(best, evaluate(hand[c[0]], hand[c[1]], hand[c[2]], hand[c[3]], hand[c[4]]));
+			}
+			return best;
+		}
+	}
+
+	std::string_view to_string(Category category)
+	{
+		switch (category)
+		{
+		case Category::HighCard:
+			return "high card";
+		case Category::Pair:
+			return "pair";
+		case Category::TwoPair:
+			return "two pair";
+		case Category::ThreeOfAKind:
+			return "three of a kind";
+		case Category::Straight:
+			return "straight";
+		case Category::Flush:
+			return "flush";
+		case Category::FullHouse:
+			return "full house";
+		case Category::FourOfAKind:
+			return "four of a kind";
+		case Category::StraightFlush:
+			return "straight flush";
+		default:
+			return "?";
+		}
+	}
+
+	Category category(Strength strength)
+	{
+		int index = 0;
+		for (Strength last = category_sizes[0]; strength > last; last += category_sizes[++index]) {
+		}
+		return static_cast<Category>(index);
+	}
+
+	Strength evaluate(const std::array<cards::PackedCard, 5>& hand)
+	{
+		return evaluate(kev_cards[hand[0].code()], kev_cards[hand[1].code()], kev_cards[hand[2].code()],
+			kev_cards[hand[3].code()], kev_cards[hand[4].code()]);
+	}
+
+	Strength evaluate(const std::array<cards::PackedCard, 7>& hand)
+	{
+		std::array<KevCard, 7> kev;
+		std::ranges::transform(hand, kev.begin(), [](cards::PackedCard card) { return kev_cards[card.code()]; });
+		return evaluate(kev);
+	}
+
+	std::array<std::uint64_t, 9> count_five_card_hands()
+	{
+		std::array<std::uint64_t, 9> counts{};
+		std::array<std::uint64_t, strongest + 1> by_strength{};
+		constexpr std::size_t n = kev_cards.size();
+		for (std::size_t a = 0; a < n; ++a) {
+			for (std::size_t b = a + 1; b < n; ++b) {
+				for (std::size_t c = b + 1; c < n; ++c) {
+					for (std::size_t d = c + 1; d < n; ++d) {
+						for (std::size_t e = d + 1; e < n; ++e) {
+							++by_strength[evaluate(kev_cards[a], kev_cards[b], kev_cards[c], kev_cards[d], kev_cards[e])];
+						}
+					}
+				}
+			}
+		}
+		for (std::size_t strength = weakest; strength <= strongest; ++strength) {
+			counts[static_cast<std::size_t>(category(static_cast<Strength>(strength)))] += by_strength[strength];
+		}
+		return counts;
+	}
+
+	Equity equity(std::span<const Hole> players, std::span<const cards::PackedCard> board, unsigned threads)
+	{
+		if (players.size() < 2) {
+			throw std::invalid_argument("Equity needs at least two players");
+		}
+		if (board.size() > 5) {
+			throw std::invalid_argument("A board has at most five cards");
+		}
+		std::uint64_t used = 0;
+		auto use = [&used](cards::PackedCard card) {
+			if (card.code() >= cards::PackedCard::joker_code) {
+				throw std::invalid_argument("Jokers are not poker cards");
+			}
+			const std::uint64_t bit = std::uint64_t{ 1 } << card.code();
+			if (used & bit) {
+				throw std::invalid_argument("A card was dealt twice");
+			}
+			used |= bit;
+		};
+		for (const auto& hole : players) {
+			use(hole[0]);
+			use(hole[1]);
+		}
+		for (auto card : board) {
+			use(card);
+		}
+
+		std::vector<KevCard> deck;
+		for (std::uint32_t code = 0; code < kev_cards.size(); ++code) {
+			if (!(used & (std::uint64_t{ 1 } << code))) {
+				deck.push_back(kev_cards[code]);
+			}
+		}
+		const std::size_t missing = 5 - board.size();
+		if (deck.size() < missing) {
+			throw std::invalid_argument("Too few cards are left to finish the board");
+		}
+		std::vector<std::array<KevCard, 7>> hands(players.size());
+		for (std::size_t p = 0; p < players.size(); ++p) {
+			hands[p][0] = kev_cards[players[p][0].code()];
+			hands[p][1] = kev_cards[players[p][1].code()];
+			for (std::size_t i = 0; i < board.size(); ++i) {
+				hands[p][2 + i] = kev_cards[board[i].code()];
+			}
+		}
+
+		threads = std::max(threads, 1u);
+		std::vector<Equity> results(threads);
+		std::atomic<std::size_t> next_first{ 0 };
+		// Threads take the first missing card in turn; lower first cards
+		// leave more boards to deal, so handing them out one at a time
+		// keeps the threads evenly loaded.
+		auto work = [&](unsigned thread) {
+			Equity result;
+			result.shares.assign(players.size(), 0);
+			auto local_hands = hands;
+			std::vector<Strength> strengths(players.size());
+			auto settle = [&] {
+				Strength best = 0;
+				int winners = 0;
+				for (std::size_t p = 0; p < local_hands.size(); ++p) {
+					strengths[p] = evaluate(local_hands[p]);
+					if (strengths[p] > best) {
+						best = strengths[p];
+						winners = 0;
+					}
+					winners += strengths[p] == best;
+				}
+				const double share = 1.0 / winners;
+				for (std::size_t p = 0; p < local_hands.size(); ++p) {
+					if (strengths[p] == best) {
+						result.shares[p] += share;
+					}
+				}
+				++result.boards;
+			};
+			auto deal = [&](auto& self, std::size_t slot, std::size_t from) -> void {
+				if (slot == 7) {
+					settle();
+					return;
+				}
+				for (std::size_t i = from; i < deck.size(); ++i) {
+					for (auto& hand : local_hands) {
+						hand[slot] = deck[i];
+					}
+					self(self, slot + 1, i + 1);
+				}
+			};
+			const std::size_t first_slot = 7 - missing;
+			if (missing == 0) {
+				if (thread == 0) {
+					settle();
+				}
+			}
+			else {
+				for (std::size_t first; (first = next_first++) < deck.size();) {
+					for (auto& hand : local_hands) {
+						hand[first_slot] = deck[first];
+					}
+					deal(deal, first_slot + 1, first + 1);
+				}
+			}
+			results[thread] = std::move(result);
+		};
+
+		auto start = std::chrono::steady_clock::now();
+		{
+			std::vector<std::jthread> workers;
+			for (unsigned thread = 1; thread < threads; ++thread) {
+				workers.emplace_back(work, thread);
+			}
+			work(0);
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		Equity total;
+		total.shares.assign(players.size(), 0);
+		for (const auto& result : results) {
+			std::ranges::transform(total.shares, result.shares, total.shares.begin(), std::plus<>{});
+			total.boards += result.boards;
+		}
+		for (auto& share : total.shares) {
+			share /= static_cast<double>(total.boards);
+		}
+		total.seconds = elapsed.count();
+		return total;
+	}
+
+	void check_poker()
+	{
+		using cards::Card;
+		using cards::FaceValue;
+		using cards::Suit;
+		auto card = [](int value, Suit suit) { return cards::PackedCard{ Card{ FaceValue(value), suit } }; };
+
+		// The well known counts of each kind of five card hand.
+		constexpr std::array<std::uint64_t, 9> expected{
+			1'302'540, 1'098'240, 123'552, 54'912, 10'200, 5'108, 3'744, 624, 40 };
+		assert(count_five_card_hands() == expected);
+
+		const std::array<cards::PackedCard, 5> royal_flush{
+			card(1, Suit::Spades), card(13, Suit::Spades), card(12, Suit::Spades),
+			card(11, Suit::Spades), card(10, Suit::Spades) };
+		assert(evaluate(royal_flush) == strongest);
+		const std::array<cards::PackedCard, 5> wheel{
+			card(1, Suit::Hearts), card(2, Suit::Spades), card(3, Suit::Clubs),
+			card(4, Suit::Diamonds), card(5, Suit::Hearts) };
+		const std::array<cards::PackedCard, 5> six_high{
+			card(6, Suit::Hearts), card(2, Suit::Spades), card(3, Suit::Clubs),
+			card(4, Suit::Diamonds), card(5, Suit::Hearts) };
+		assert(category(evaluate(wheel)) == Category::Straight);
+		assert(evaluate(wheel) < evaluate(six_high));
+
+		// Two pair on the board with a better kicker in the hole.
+		const std::array<cards::PackedCard, 7> seven{
+			card(1, Suit::Hearts), card(9, Suit::Clubs),
+			card(8, Suit::Spades), card(8, Suit::Hearts), card(4, Suit::Clubs),
+			card(4, Suit::Diamonds), card(2, Suit::Hearts) };
+		assert(category(evaluate(seven)) == Category::TwoPair);
+
+		// Players with the same ranks split every pot.
+		const std::array<Hole, 2> same{ {
+			{ card(13, Suit::Hearts), card(12, Suit::Hearts) },
+			{ card(13, Suit::Clubs), card(12, Suit::Clubs) } } };
+		const std::array<cards::PackedCard, 3> flop{
+			card(2, Suit::Spades), card(7, Suit::Diamonds), card(9, Suit::Spades) };
+		const Equity split = equity(same, flop);
+		assert(split.boards == 990);
+		assert(split.shares[0] > 0.45 && split.shares[0] < 0.55);
+		assert(std::abs(split.shares[0] + split.shares[1] - 1) < 1e-9);
+
+		// 24 players hold 48 cards, leaving 4 for a five card board.
+		std::vector<Hole> crowd(24);
+		for (std::size_t p = 0; p < crowd.size(); ++p) {
+			crowd[p] = { card(static_cast<int>(p / 2 + 1), static_cast<Suit>(p % 2 * 2)),
+				card(static_cast<int>(p / 2 + 1), static_cast<Suit>(p % 2 * 2 + 1)) };
+		}
+		bool threw = false;
+		try {
+			equity(crowd, {});
+		}
+		catch (const std::invalid_argument&) {
+			threw = true;
+		}
+		assert(threw);
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "packed_card.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace poker
+{
+	enum class Category
+	{
+		HighCard,
+		Pair,
+		TwoPair,
+		ThreeOfAKind,
+		Straight,
+		Flush,
+		FullHouse,
+		FourOfAKind,
+		StraightFlush
+	};
+
+	std::string_view to_string(Category category);
+
+	// Where a hand stands among the 7462 distinct five card hands, from
+	// 1 for 7-5-4-3-2 in mixed suits to 7462 for a royal flush. Aces
+	// are high, except in the five high straight.
+	using Strength = std::uint16_t;
+
+	constexpr Strength weakest = 1;
+	constexpr Strength strongest = 7462;
+
+	Category category(Strength strength);
+
+	// Jokers are not poker cards; neither overload checks for them.
+	Strength evaluate(const std::array<cards::PackedCard, 5>& hand);
+
+	// The strongest five of the seven cards.
+	Strength evaluate(const std::array<cards::PackedCard, 7>& hand);
+
+	// How many of each category turn up among all C(52, 5) hands, by
+	// evaluating every one of them.
+	std::array<std::uint64_t, 9> count_five_card_hands();
+
+	using Hole = std::array<cards::PackedCard, 2>;
+
+	struct Equity
+	{
+		// Each player's share of the pots, with ties split evenly.
+		std::vector<double> shares;
+		std::uint64_t boards = 0;
+		double seconds = 0;
+
+		double boards_per_second() const { return boards / seconds; }
+	};
+
+	// Deals every way of finishing the board and shares out each pot.
+	// Throws std::invalid_argument for fewer than two players, more
+	// than five board cards, jokers, a card dealt twice, or too few
+	// cards left to finish the board.
+	Equity equity(std::span<const Hole> players, std::span<const cards::PackedCard> board,
+		unsigned threads = std::thread::hardware_concurrency());
+
+	void check_poker();
+}
@@ -0,0 +1,88 @@
+#include "shoe.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <stdexcept>
+
+namespace cards
+{
+	Shoe::Shoe(std::size_t decks, double penetration, std::uint64_t seed) :
+		shuffler_(seed)
+	{
+		if (decks == 0) {
+			throw std::invalid_argument("A shoe needs at least one deck");
+		}
+		if (!(penetration > 0 && penetration <= 1)) {
+			throw std::invalid_argument("Penetration must be above 0 and at most 1");
+		}
+		const PackedDeck deck = create_packed_deck();
+		cards_.reserve(decks * deck.size());
+		for (std::size_t i = 0; i < decks; ++i) {
+			cards_.insert(cards_.end(), deck.begin(), deck.end());
+		}
+		cut_ = std::max<std::size_t>(1, static_cast<std::size_t>(penetration * cards_.size()));
+	}
+
+	Shoe::Shoe(std::size_t decks, double penetration) :
+		Shoe(decks, penetration, Shuffler::local().engine()())
+	{
+	}
+
+	PackedCard Shoe::draw()
+	{
+		if (dealt_ == cards_.size()) {
+			throw std::out_of_range("The shoe is empty");
+		}
+		const std::size_t chosen = dealt_ + shuffler_.bounded(static_cast<std::uint32_t>(remaining()));
+		std::swap(cards_[dealt_], cards_[chosen]);
+		return cards_[dealt_++];
+	}
+
+	void check_shoe()
+	{
+		Shoe shoe(6, 0.75, 2026);
+		assert(shoe.size() == 6 * 54);
+		const PackedCard* storage = shoe.dealt_cards().data();
+
+		// A pass through the shoe deals each card of each deck once.
+		for (int pass = 0; pass < 3; ++pass) {
+			std::array<int, 53> counts{};
+			while (shoe.remaining()) {
+				++counts[shoe.draw().code()];
+			}
+			for (std::size_t code = 0; code < PackedCard::joker_code; ++code) {
+				assert(counts[code] == 6);
+			}
+			assert(counts[PackedCard::joker_code] == 12);
+			shoe.reshuffle();
+		}
+		assert(shoe.dealt_cards().data() == storage);
+
+		bool threw = false;
+		try {
+			Shoe empty(1, 1, 1);
+			for (int i = 0; i < 55; ++i) {
+				empty.draw();
+			}
+		}
+		catch (const std::out_of_range&) {
+			threw = true;
+		}
+		assert(threw);
+
+		// After reshuffling at the cut card, the first card out is each
+		// code about equally often.
+		std::array<int, 53> first{};
+		for (int hand = 0; hand < 54'000; ++hand) {
+			while (!shoe.past_cut()) {
+				shoe.draw();
+			}
+			shoe.reshuffle();
+			++first[shoe.draw().code()];
+		}
+		for (std::size_t code = 0; code < PackedCard::joker_code; ++code) {
+			assert(first[code] > 800 && first[code] < 1200);
+		}
+	}
+}
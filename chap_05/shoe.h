@@ -0,0 +1,52 @@
+#pragma once
+
+#include "packed_card.h"
+#include "shuffler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace cards
+{
+	// Several extended decks dealt one card at a time. Nothing is
+	// shuffled up front: each draw swaps a random undealt card into
+	// place, one step of Fisher-Yates, so a draw costs the same however
+	// large the shoe. The undealt cards are always some order of the
+	// cards not yet seen, and the dealt ones of the rest, so
+	// reshuffling only has to forget what has been dealt.
+	class Shoe
+	{
+	public:
+		// Throws std::invalid_argument for no decks, or a penetration,
+		// the share of the shoe dealt before the cut card, outside (0, 1].
+		Shoe(std::size_t decks, double penetration, std::uint64_t seed);
+
+		explicit Shoe(std::size_t decks, double penetration = 0.75);
+
+		// Throws std::out_of_range once every card has been dealt.
+		PackedCard draw();
+
+		// Puts every card back; no cards are moved or allocated.
+		void reshuffle() { dealt_ = 0; }
+
+		// True once the cut card has come out, when a casino would
+		// reshuffle before the next hand.
+		bool past_cut() const { return dealt_ >= cut_; }
+
+		std::size_t size() const { return cards_.size(); }
+		std::size_t dealt() const { return dealt_; }
+		std::size_t remaining() const { return cards_.size() - dealt_; }
+
+		// The cards dealt since the last reshuffle, in order.
+		std::span<const PackedCard> dealt_cards() const { return { cards_.data(), dealt_ }; }
+	private:
+		std::vector<PackedCard> cards_;
+		std::size_t dealt_ = 0;
+		std::size_t cut_;
+		Shuffler shuffler_;
+	};
+
+	void check_shoe();
+}
@@ -0,0 +1,59 @@
+#include "shuffler.h"
+#include "packed_card.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <random>
+#include <vector>
+
+namespace cards
+{
+	Shuffler& Shuffler::local()
+	{
+		thread_local Shuffler shuffler{ [] {
+			std::random_device rd;
+			return std::uint64_t{ rd() } << 32 | rd();
+		}() };
+		return shuffler;
+	}
+
+	void Shuffler::shuffle_each(std::span<PackedDeck> decks)
+	{
+		// Shuffle with a copy: the cards are bytes, and a store to a byte
+		// may alias the engine's state, which would then go back to
+		// memory on every swap.
+		Shuffler copy = *this;
+		for (auto& deck : decks) {
+			copy.shuffle(deck.cards);
+		}
+		*this = copy;
+	}
+
+	void check_shuffler()
+	{
+		Shuffler shuffler{ 2026 };
+		for (std::uint32_t range = 1; range <= 64; ++range) {
+			for (int i = 0; i < 1000; ++i) {
+				assert(shuffler.bounded(range) < range);
+			}
+		}
+
+		// Every shuffle is a permutation, and each card turns up on top
+		// about equally often.
+		std::vector<PackedDeck> decks(54 * 1000, create_packed_deck());
+		PackedDeck sorted = create_packed_deck();
+		std::ranges::sort(sorted);
+		shuffler.shuffle_each(decks);
+		std::array<int, 53> on_top{};
+		for (auto deck : decks) {
+			++on_top[deck[0].code()];
+			std::ranges::sort(deck);
+			assert(deck.cards == sorted.cards);
+		}
+		for (std::size_t code = 0; code < PackedCard::joker_code; ++code) {
+			assert(on_top[code] > 800 && on_top[code] < 1200);
+		}
+		assert(on_top[PackedCard::joker_code] > 1700 && on_top[PackedCard::joker_code] < 2300);
+	}
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <utility>
+
+namespace cards
+{
+	struct PackedDeck;
+
+	// xoshiro256** by Blackman and Vigna: 32 bytes of state, a few
+	// shifts, rotates and multiplies per number. Meets the standard's
+	// uniform random bit generator requirements, so it works with the
+	// <random> distributions too.
+	class Xoshiro256
+	{
+	public:
+		using result_type = std::uint64_t;
+
+		// Expands the seed with splitmix64, as the authors recommend, so
+		// similar seeds give unrelated streams.
+		constexpr explicit Xoshiro256(std::uint64_t seed)
+		{
+			for (auto& word : state_) {
+				seed += 0x9e3779b97f4a7c15;
+				std::uint64_t z = seed;
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+				word = z ^ (z >> 31);
+			}
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+		constexpr result_type operator()()
+		{
+			const std::uint64_t result = std::rotl(state_[1] * 5, 7) * 9;
+			const std::uint64_t t = state_[1] << 17;
+			state_[2] ^= state_[0];
+			state_[3] ^= state_[1];
+			state_[1] ^= state_[2];
+			state_[0] ^= state_[3];
+			state_[2] ^= t;
+			state_[3] = std::rotl(state_[3], 45);
+			return result;
+		}
+
+		// Moves 2^128 numbers ahead, so engines jumped different numbers
+		// of times from one seed give streams that never overlap.
+		constexpr void jump()
+		{
+			constexpr std::uint64_t polynomial[] = {
+				0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+			std::uint64_t jumped[4]{};
+			for (const std::uint64_t word : polynomial) {
+				for (int bit = 0; bit < 64; ++bit) {
+					if (word & (std::uint64_t{ 1 } << bit)) {
+						for (int i = 0; i < 4; ++i) {
+							jumped[i] ^= state_[i];
+						}
+					}
+					(*this)();
+				}
+			}
+			for (int i = 0; i < 4; ++i) {
+				state_[i] = jumped[i];
+			}
+		}
+	private:
+		std::uint64_t state_[4]{};
+	};
+
+	// Shuffles with its own engine. Each thread has one, seeded once
+	// from std::random_device, so a shuffle pays for neither seeding
+	// nor a large engine state.
+	class Shuffler
+	{
+	public:
+		explicit Shuffler(std::uint64_t seed) : engine_(seed)
+		{
+		}
+
+		// The calling thread's shuffler.
+		static Shuffler& local();
+
+		// A uniform number in [0, range) by Lemire's method: the high half
+		// of a 32 by 32 bit product, with no division unless the low half
+		// lands in the small biased zone, less than range in 2^32 draws.
+		std::uint32_t bounded(std::uint32_t range)
+		{
+			std::uint64_t product = std::uint64_t{ next() } * range;
+			auto low = static_cast<std::uint32_t>(product);
+			if (low < range) {
+				const std::uint32_t threshold = (0u - range) % range;
+				while (low < threshold) {
+					product = std::uint64_t{ next() } * range;
+					low = static_cast<std::uint32_t>(product);
+				}
+			}
+			return static_cast<std::uint32_t>(product >> 32);
+		}
+
+		// Fisher-Yates, from the back.
+		template<std::ranges::random_access_range R>
+		void shuffle(R&& range)
+		{
+			auto first = std::ranges::begin(range);
+			const auto size = static_cast<std::uint32_t>(std::ranges::distance(range));
+			for (std::uint32_t i = size; i > 1; --i) {
+				const std::uint32_t j = bounded(i);
+				std::ranges::iter_swap(first + (i - 1), first + j);
+			}
+		}
+
+		// Shuffles every deck, each independently.
+		void shuffle_each(std::span<PackedDeck> decks);
+
+		Xoshiro256& engine() { return engine_; }
+	private:
+		std::uint32_t next()
+		{
+			return static_cast<std::uint32_t>(engine_() >> 32);
+		}
+
+		Xoshiro256 engine_;
+	};
+
+	void check_shuffler();
+}
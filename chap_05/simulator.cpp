@@ -0,0 +1,129 @@
+#include "simulator.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <numeric>
+#include <vector>
+
+namespace simulator
+{
+	namespace
+	{
+		constexpr std::uint64_t all_cards = (std::uint64_t{ 1 } << cards::PackedCard::joker_code) - 1;
+		constexpr std::uint8_t middle_code = cards::PackedCard::joker_code / 2;
+	}
+
+	std::string_view to_string(Policy policy)
+	{
+		switch (policy)
+		{
+		case Policy::Naive:
+			return "naive";
+		case Policy::Midpoint:
+			return "midpoint";
+		case Policy::Counting:
+			return "card counting";
+		default:
+			return "?";
+		}
+	}
+
+	double Report::mean() const
+	{
+		std::uint64_t total = 0;
+		for (std::size_t streak = 0; streak < streak_counts.size(); ++streak) {
+			total += streak * streak_counts[streak];
+		}
+		return games ? static_cast<double>(total) / games : 0;
+	}
+
+	std::size_t Report::longest() const
+	{
+		std::size_t streak = streak_counts.size() - 1;
+		while (streak > 0 && streak_counts[streak] == 0) {
+			--streak;
+		}
+		return streak;
+	}
+
+	char choose(Policy policy, cards::PackedCard current, std::uint64_t unseen, cards::Shuffler& shuffler)
+	{
+		switch (policy)
+		{
+		case Policy::Naive:
+			return shuffler.bounded(2) ? 'h' : 'l';
+		case Policy::Midpoint:
+			return current.code() < middle_code ? 'h' : 'l';
+		case Policy::Counting:
+		{
+			// Any guess is right after a joker, and a joker still to come
+			// is right either way, so only unseen cards count.
+			if (current.is_joker()) {
+				return 'h';
+			}
+			const int code = current.code();
+			const int higher = std::popcount(unseen >> (code + 1));
+			const int lower = std::popcount(unseen & ((std::uint64_t{ 1 } << code) - 1));
+			return higher >= lower ? 'h' : 'l';
+		}
+		default:
+			return 'h';
+		}
+	}
+
+	std::size_t play(Policy policy, cards::PackedDeck& deck, cards::Shuffler& shuffler)
+	{
+		shuffler.shuffle(deck.cards);
+		std::uint64_t unseen = all_cards;
+		std::size_t streak = 0;
+		for (; streak + 1 < deck.size(); ++streak) {
+			const cards::PackedCard current = deck[streak];
+			unseen &= ~(std::uint64_t{ 1 } << current.code());
+			const char guess = choose(policy, current, unseen, shuffler);
+			if (!cards::is_guess_correct(guess, current, deck[streak + 1])) {
+				break;
+			}
+		}
+		return streak;
+	}
+
+	Report simulate(Policy policy, std::uint64_t games, std::uint64_t seed, unsigned threads)
+	{
+		threads = std::max(threads, 1u);
+		std::vector<Report> reports(threads);
+		auto work = [&](unsigned thread) {
+			cards::Shuffler shuffler{ seed };
+			for (unsigned jumps = 0; jumps < thread; ++jumps) {
+				shuffler.engine().jump();
+			}
+			auto deck = cards::to_packed(cards::create_extended_deck());
+			// Count locally, so threads never share a cache line.
+			Report report;
+			report.games = games / threads + (thread < games % threads);
+			for (std::uint64_t game = 0; game < report.games; ++game) {
+				++report.streak_counts[play(policy, deck, shuffler)];
+			}
+			reports[thread] = report;
+		};
+
+		auto start = std::chrono::steady_clock::now();
+		{
+			std::vector<std::jthread> workers;
+			for (unsigned thread = 1; thread < threads; ++thread) {
+				workers.emplace_back(work, thread);
+			}
+			work(0);
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		Report report;
+		for (const auto& thread_report : reports) {
+			std::ranges::transform(report.streak_counts, thread_report.streak_counts,
+				report.streak_counts.begin(), std::plus<>{});
+			report.games += thread_report.games;
+		}
+		report.seconds = elapsed.count();
+		return report;
+	}
+}
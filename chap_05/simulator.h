@@ -0,0 +1,51 @@
+#pragma once
+
+#include "packed_card.h"
+#include "shuffler.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+
+namespace simulator
+{
+	enum class Policy
+	{
+		Naive,    // toss a coin between higher and lower
+		Midpoint, // higher below the middle card, lower above it
+		Counting  // whichever way more of the unseen cards lie
+	};
+
+	std::string_view to_string(Policy policy);
+
+	// A streak is how many guesses were right before the first wrong
+	// one; a game that gets through the deck scores 53.
+	constexpr std::size_t longest_streak = 53;
+
+	struct Report
+	{
+		// streak_counts[s] is how many games ended with a streak of s.
+		std::array<std::uint64_t, longest_streak + 1> streak_counts{};
+		std::uint64_t games = 0;
+		double seconds = 0;
+
+		double mean() const;
+		std::size_t longest() const;
+		double games_per_second() const { return games / seconds; }
+	};
+
+	// The guess a player using policy makes on seeing current, where
+	// unseen has bit c set for each card code c not yet dealt.
+	char choose(Policy policy, cards::PackedCard current, std::uint64_t unseen, cards::Shuffler& shuffler);
+
+	// Shuffles deck and plays it through, returning the streak.
+	std::size_t play(Policy policy, cards::PackedDeck& deck, cards::Shuffler& shuffler);
+
+	// Plays games without a person, spread over threads. Each thread
+	// draws from its own stream of one xoshiro256** sequence, so the
+	// results depend only on the seed and the number of threads.
+	Report simulate(Policy policy, std::uint64_t games, std::uint64_t seed,
+		unsigned threads = std::thread::hardware_concurrency());
+}
@@ -1,13 +1,18 @@
+#include "buffered_reader.h"
+
 #include <cassert>
+#include <chrono>
 #include <coroutine>
 #include <functional>
 #include <generator>
 #include <iostream>
+#include <istream>
 #include <memory>
 #include <optional>
 #include <random>
 #include <ranges>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -180,6 +185,20 @@ std::optional<int> read_number(std::istream& in)
 	return {};
 }
 
+std::optional<int> read_number(input::BufferedReader& in)
+{
+	auto line = in.next_line();
+	if (line == "0")
+	{
+		return { 0 };
+	}
+	else if (line == "1")
+	{
+		return { 1 };
+	}
+	return {};
+}
+
 void pennies_game()
 {
 	int player_wins = 0;
@@ -321,14 +340,14 @@ private:
 	Task(promise_type* p) : promise(p) {}
 };
 
-Task coroutine_game()
+Task coroutine_game(auto& in)
 {
 	std::mt19937 gen{ std::random_device{}() };
 	std::uniform_int_distribution dist{ 0, 1 };
 	MindReader mr(gen, dist);
 	while (true)
 	{
-		auto input = read_number(std::cin);
+		auto input = read_number(in);
 		if (!input)
 		{
 			co_return;
@@ -339,17 +358,17 @@ Task coroutine_game()
 	}
 }
 
-void coroutine_mind_reader()
+// Returns the number of turns played.
+int coroutine_mind_reader(auto& in, std::ostream& out)
 {
 	int player_wins = 0;
 	int turns = 0;
-	
 
-	std::cout << "Select 0 or 1 at random and press enter.\n";
-	std::cout << "If the computer predicts your guess it wins.\n"
+	out << "Select 0 or 1 at random and press enter.\n";
+	out << "If the computer predicts your guess it wins.\n"
 		<< "and it can now read your mind.\n";
 
-	Task game = coroutine_game();
+	Task game = coroutine_game(in);
 
 	while (!game.done())
 	{
@@ -357,7 +376,7 @@ void coroutine_mind_reader()
 			game.choice_and_prediction();
 
 		++turns;
-		std::cout << "You pressed " << player_choice <<
+		out << "You pressed " << player_choice <<
 			" , I guessed " << prediction << '\n';
 
 		if (player_choice != prediction)
@@ -366,8 +385,30 @@ void coroutine_mind_reader()
 		}
 		game.next();
 	}
-	std::cout << "You win " << player_wins << '\n'
+	out << "You win " << player_wins << '\n'
 		<< "I win " << turns - player_wins << '\n';
+	return turns;
+}
+
+void coroutine_mind_reader()
+{
+	coroutine_mind_reader(std::cin, std::cout);
+}
+
+// Plays a recorded session from stdin, one 0 or 1 per line,
+// and reports the rate on stderr.
+void replay_session()
+{
+	std::ios::sync_with_stdio(false);
+	input::BufferedReader reader(std::cin);
+	const auto start = std::chrono::steady_clock::now();
+	const int turns = coroutine_mind_reader(reader, std::cout);
+	std::cout.flush();
+	const std::chrono::duration<double> taken =
+		std::chrono::steady_clock::now() - start;
+	std::cerr << turns << " turns, "
+		<< static_cast<long long>(taken.count() > 0 ? turns / taken.count() : 0)
+		<< " turns/sec\n";
 }
 
 void check_properties()
@@ -379,7 +420,11 @@ void check_properties()
 	}
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+	if (argc > 1 && std::string_view(argv[1]) == "--replay") {
+		replay_session();
+		return 0;
+	}
 	//mind_reader();
 	//generator_experiment();
 	coroutine_mind_reader();